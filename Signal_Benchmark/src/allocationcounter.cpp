@@ -0,0 +1,77 @@
+#include "allocationcounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+	std::atomic<std::size_t> allocationCount{0};
+	std::atomic<std::size_t> allocationBytes{0};
+
+	void* allocate(std::size_t size) {
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		allocationBytes.fetch_add(size, std::memory_order_relaxed);
+		if (auto ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) {
+			return ptr;
+		}
+		throw std::bad_alloc{};
+	}
+
+}
+
+namespace benchmark {
+
+	Allocations allocations() {
+		return {allocationCount.load(std::memory_order_relaxed), allocationBytes.load(std::memory_order_relaxed)};
+	}
+
+}
+
+void* operator new(std::size_t size) {
+	return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+	return allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	try {
+		return allocate(size);
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	try {
+		return allocate(size);
+	} catch (...) {
+		return nullptr;
+	}
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+	std::free(ptr);
+}
@@ -0,0 +1,23 @@
+#ifndef SIGNAL_BENCHMARK_ALLOCATIONCOUNTER_H
+#define SIGNAL_BENCHMARK_ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+namespace benchmark {
+
+	struct Allocations {
+		std::size_t count = 0;
+		std::size_t bytes = 0;
+
+		Allocations operator-(const Allocations& allocations) const {
+			return {count - allocations.count, bytes - allocations.bytes};
+		}
+	};
+
+	/// @brief Return the number of calls to the replaced global operator new, and the bytes requested,
+	/// since program start. Over-aligned allocations are not counted.
+	Allocations allocations();
+
+}
+
+#endif
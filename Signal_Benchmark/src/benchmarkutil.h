@@ -0,0 +1,103 @@
+#ifndef SIGNAL_BENCHMARK_BENCHMARKUTIL_H
+#define SIGNAL_BENCHMARK_BENCHMARKUTIL_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace benchmark {
+
+	using Clock = std::chrono::steady_clock;
+
+	/// @brief Command line options given as --name=value.
+	class Options {
+	public:
+		Options(int argc, char** argv) {
+			for (int i = 1; i < argc; ++i) {
+				std::string_view arg = argv[i];
+				if (!arg.starts_with("--")) {
+					std::cerr << "Ignoring argument: " << arg << "\n";
+					continue;
+				}
+				arg.remove_prefix(2);
+				auto equal = arg.find('=');
+				if (equal == std::string_view::npos) {
+					values_.insert_or_assign(std::string{arg}, std::string{"1"});
+				} else {
+					values_.insert_or_assign(std::string{arg.substr(0, equal)}, std::string{arg.substr(equal + 1)});
+				}
+			}
+		}
+
+		bool has(const std::string& name) const {
+			return values_.contains(name);
+		}
+
+		long long integer(const std::string& name, long long defaultValue) const {
+			auto it = values_.find(name);
+			return it == values_.end() ? defaultValue : std::atoll(it->second.c_str());
+		}
+
+		double real(const std::string& name, double defaultValue) const {
+			auto it = values_.find(name);
+			return it == values_.end() ? defaultValue : std::atof(it->second.c_str());
+		}
+
+	private:
+		std::map<std::string, std::string> values_;
+	};
+
+	/// @brief Return the peak resident set size of the process in bytes.
+	inline std::size_t peakRss() {
+#if defined(_WIN32)
+		PROCESS_MEMORY_COUNTERS counters{};
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+			return counters.PeakWorkingSetSize;
+		}
+		return 0;
+#else
+		rusage usage{};
+		getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+		return static_cast<std::size_t>(usage.ru_maxrss);
+#else
+		return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+	}
+
+	/// @brief Return the value at the given percentile, the samples are sorted in place.
+	inline Clock::duration percentile(std::vector<Clock::duration>& samples, double percent) {
+		if (samples.empty()) {
+			return {};
+		}
+		std::sort(samples.begin(), samples.end());
+		auto index = static_cast<std::size_t>(percent / 100.0 * static_cast<double>(samples.size() - 1) + 0.5);
+		return samples[std::min(index, samples.size() - 1)];
+	}
+
+	inline double microseconds(Clock::duration duration) {
+		return std::chrono::duration<double, std::micro>(duration).count();
+	}
+
+	inline double seconds(Clock::duration duration) {
+		return std::chrono::duration<double>(duration).count();
+	}
+
+}
+
+#endif
@@ -0,0 +1,141 @@
+#include "benchmarkutil.h"
+
+#include <mw/realtimesignal.h>
+#include <mw/shardedsignal.h>
+
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Throughput of ShardedSignal from 1 up to many threads, compared with RealtimeSignal for
+// connect/disconnect, i.e. a single lock and a slot list copied on every write.
+//
+// Options (--name=value):
+//   --maxThreads  largest number of threads, doubled from 1, default 64
+//   --duration    milliseconds per measurement, default 200
+//   --listeners   slots connected before each measurement, default 64
+//   --shards      shards of the ShardedSignal, 0 is one per hardware thread, default 0
+
+namespace {
+
+	void slot(int value) {
+		thread_local int sink = 0;
+		sink += value;
+	}
+
+	// Runs the work in the given number of threads for the duration and returns operations per second.
+	// The work is called repeatedly and returns the number of operations done.
+	template <typename Work>
+	double measure(int threads, std::chrono::milliseconds duration, Work work) {
+		std::atomic<bool> start{false};
+		std::atomic<bool> stop{false};
+		std::atomic<long long> operations{0};
+		std::vector<std::thread> workers;
+		for (int i = 0; i < threads; ++i) {
+			workers.emplace_back([&]() {
+				while (!start.load(std::memory_order_acquire)) {
+					std::this_thread::yield();
+				}
+				long long done = 0;
+				while (!stop.load(std::memory_order_relaxed)) {
+					done += work();
+				}
+				operations += done;
+			});
+		}
+		const auto begin = benchmark::Clock::now();
+		start.store(true, std::memory_order_release);
+		std::this_thread::sleep_for(duration);
+		stop.store(true, std::memory_order_relaxed);
+		for (auto& worker : workers) {
+			worker.join();
+		}
+		return static_cast<double>(operations) / benchmark::seconds(benchmark::Clock::now() - begin);
+	}
+
+	template <typename Signal>
+	std::vector<mw::signals::Connection> connectListeners(Signal& signal, int listeners) {
+		std::vector<mw::signals::Connection> connections;
+		for (int i = 0; i < listeners; ++i) {
+			connections.push_back(signal.connect(&slot));
+		}
+		return connections;
+	}
+
+	// Connect and disconnect, counted as one operation.
+	template <typename Signal>
+	double connectDisconnect(int threads, std::chrono::milliseconds duration, int listeners, Signal& signal) {
+		auto connections = connectListeners(signal, listeners);
+		auto result = measure(threads, duration, [&signal]() {
+			auto connection = signal.connect(&slot);
+			connection.disconnect();
+			return 1;
+		});
+		signal.clear();
+		return result;
+	}
+
+	// Slot calls.
+	double emit(int threads, std::chrono::milliseconds duration, int listeners, mw::ShardedSignal<int>& signal) {
+		auto connections = connectListeners(signal, listeners);
+		auto result = measure(threads, duration, [&signal, listeners]() {
+			signal(1);
+			return listeners;
+		});
+		signal.clear();
+		return result;
+	}
+
+	// One connect and disconnect every tenth emit, counted as one operation each.
+	double mixed(int threads, std::chrono::milliseconds duration, int listeners, mw::ShardedSignal<int>& signal) {
+		auto connections = connectListeners(signal, listeners);
+		auto result = measure(threads, duration, [&signal]() {
+			for (int i = 0; i < 9; ++i) {
+				signal(1);
+			}
+			auto connection = signal.connect(&slot);
+			signal(1);
+			connection.disconnect();
+			return 11;
+		});
+		signal.clear();
+		return result;
+	}
+
+}
+
+int main(int argc, char** argv) {
+	const benchmark::Options options{argc, argv};
+	const auto maxThreads = static_cast<int>(options.integer("maxThreads", 64));
+	const auto duration = std::chrono::milliseconds{options.integer("duration", 200)};
+	const auto listeners = static_cast<int>(options.integer("listeners", 64));
+	const auto shards = static_cast<std::size_t>(options.integer("shards", 0));
+
+	mw::ShardedSignal<int> sharded{shards};
+	mw::RealtimeSignal<int> realtime;
+
+	std::cout << "Scalability benchmark\n"
+		<< "Hardware threads: " << std::thread::hardware_concurrency()
+		<< ", shards: " << sharded.shards()
+		<< ", listeners: " << listeners
+		<< ", duration: " << duration.count() << " ms\n"
+		<< "Million operations per second:\n"
+		<< std::setw(8) << "threads"
+		<< std::setw(26) << "sharded connect/disc"
+		<< std::setw(26) << "single lock connect/disc"
+		<< std::setw(22) << "sharded slot calls"
+		<< std::setw(16) << "sharded mixed" << "\n"
+		<< std::fixed << std::setprecision(3);
+
+	for (int threads = 1; threads <= maxThreads; threads *= 2) {
+		std::cout << std::setw(8) << threads
+			<< std::setw(26) << connectDisconnect(threads, duration, listeners, sharded) / 1e6
+			<< std::setw(26) << connectDisconnect(threads, duration, listeners, realtime) / 1e6
+			<< std::setw(22) << emit(threads, duration, listeners, sharded) / 1e6
+			<< std::setw(16) << mixed(threads, duration, listeners, sharded) / 1e6 << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,278 @@
+#include "allocationcounter.h"
+#include "benchmarkutil.h"
+
+#include <mw/signal.h>
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Entity-scale version of the Zombie in Signal_Example. Many zombies, each with a few
+// PublicSignals and listeners held in ScopedConnections, and churn on every tick: zombies
+// spawn and despawn, listeners connect and disconnect and zombies are moved around.
+//
+// Options (--name=value):
+//   --entities   number of zombies, default 100000
+//   --listeners  listeners per signal, default 2
+//   --ticks      measured ticks, default 200
+//   --warmup     ticks before measuring, default 20
+//   --churn      percent of the zombies despawned and spawned again per tick, default 1
+//   --rewire     percent of the zombies getting their listeners reconnected per tick, default 1
+//   --relocate   all zombies are move constructed into new storage every n:th tick, 0 is never, default 50
+//   --seed       random seed, default 1
+
+namespace {
+
+	enum class GameEvent {
+		GameOver,
+		Walk
+	};
+
+	class Zombie {
+	public:
+		Zombie() = default;
+
+		Zombie(Zombie&& zombie) noexcept
+			: gameEventUpdated{std::move(zombie.gameEventUpdated)}
+			, pointsUpdated{std::move(zombie.pointsUpdated)}
+			, positionUpdated{std::move(zombie.positionUpdated)}
+			, x_{zombie.x_}
+			, points_{zombie.points_} {
+		}
+
+		Zombie& operator=(Zombie&& zombie) noexcept {
+			gameEventUpdated = std::move(zombie.gameEventUpdated);
+			pointsUpdated = std::move(zombie.pointsUpdated);
+			positionUpdated = std::move(zombie.positionUpdated);
+			x_ = zombie.x_;
+			points_ = zombie.points_;
+			return *this;
+		}
+
+		mw::PublicSignal<Zombie, GameEvent> gameEventUpdated;
+		mw::PublicSignal<Zombie, int> pointsUpdated;
+		mw::PublicSignal<Zombie, float, float> positionUpdated;
+
+		// Return the number of emissions.
+		int walk() {
+			++x_;
+			int emissions = 2;
+			gameEventUpdated(GameEvent::Walk);
+			positionUpdated(static_cast<float>(x_), 0.f);
+			if (x_ % 2 == 0) {
+				++points_;
+				pointsUpdated(points_);
+				++emissions;
+			}
+			if (x_ % 16 == 0) {
+				gameEventUpdated(GameEvent::GameOver);
+				++emissions;
+			}
+			return emissions;
+		}
+
+	private:
+		int x_ = 0;
+		int points_ = 0;
+	};
+
+	struct Stats {
+		long long walks = 0;
+		long long gameOvers = 0;
+		long long points = 0;
+		long long positions = 0;
+
+		long long slotCalls() const {
+			return walks + gameOvers + points + positions;
+		}
+	};
+
+	struct Entity {
+		Zombie zombie;
+		std::unique_ptr<mw::signals::ScopedConnections> connections = std::make_unique<mw::signals::ScopedConnections>();
+	};
+
+	struct Config {
+		std::size_t entities;
+		int listeners;
+		int ticks;
+		int warmup;
+		double churn;
+		double rewire;
+		int relocate;
+		unsigned int seed;
+	};
+
+	class Simulation {
+	public:
+		explicit Simulation(const Config& config)
+			: config_{config}
+			, random_{config.seed} {
+
+			for (std::size_t i = 0; i < config_.entities; ++i) {
+				spawn();
+			}
+		}
+
+		// Return the number of emissions.
+		long long tick(int tickNumber) {
+			churn();
+			if (config_.relocate > 0 && tickNumber % config_.relocate == 0) {
+				relocate();
+			}
+			long long emissions = 0;
+			for (auto& entity : entities_) {
+				emissions += entity.zombie.walk();
+			}
+			return emissions;
+		}
+
+		const Stats& stats() const {
+			return stats_;
+		}
+
+		std::size_t size() const {
+			return entities_.size();
+		}
+
+	private:
+		void spawn() {
+			entities_.emplace_back();
+			connect(entities_.back());
+		}
+
+		void despawn(std::size_t index) {
+			if (index != entities_.size() - 1) {
+				entities_[index] = std::move(entities_.back());
+			}
+			entities_.pop_back();
+		}
+
+		void connect(Entity& entity) {
+			auto& connections = *entity.connections;
+			for (int i = 0; i < config_.listeners; ++i) {
+				connections += {
+					entity.zombie.gameEventUpdated.connect([this](GameEvent gameEvent) {
+						switch (gameEvent) {
+							case GameEvent::GameOver:
+								++stats_.gameOvers;
+								break;
+							case GameEvent::Walk:
+								++stats_.walks;
+								break;
+						}
+					}),
+					entity.zombie.pointsUpdated.connect([this](int points) {
+						stats_.points += points > 0;
+					}),
+					entity.zombie.positionUpdated.connect([this](float x, float) {
+						stats_.positions += x > 0.f;
+					})
+				};
+			}
+		}
+
+		void churn() {
+			if (entities_.empty()) {
+				return;
+			}
+			const auto count = static_cast<std::size_t>(static_cast<double>(config_.entities) * config_.churn / 100.0);
+			for (std::size_t i = 0; i < count && !entities_.empty(); ++i) {
+				despawn(randomIndex());
+			}
+			while (entities_.size() < config_.entities) {
+				spawn();
+			}
+			const auto rewires = static_cast<std::size_t>(static_cast<double>(config_.entities) * config_.rewire / 100.0);
+			for (std::size_t i = 0; i < rewires; ++i) {
+				auto& entity = entities_[randomIndex()];
+				entity.connections->clear();
+				connect(entity);
+			}
+		}
+
+		// Move constructs all zombies into new storage, like a container growing.
+		void relocate() {
+			std::vector<Entity> entities;
+			entities.reserve(entities_.capacity());
+			for (auto& entity : entities_) {
+				entities.push_back(std::move(entity));
+			}
+			entities_ = std::move(entities);
+		}
+
+		std::size_t randomIndex() {
+			return std::uniform_int_distribution<std::size_t>{0, entities_.size() - 1}(random_);
+		}
+
+		Config config_;
+		std::mt19937 random_;
+		std::vector<Entity> entities_;
+		Stats stats_;
+	};
+
+}
+
+int main(int argc, char** argv) {
+	const benchmark::Options options{argc, argv};
+	const Config config{
+		.entities = static_cast<std::size_t>(options.integer("entities", 100'000)),
+		.listeners = static_cast<int>(options.integer("listeners", 2)),
+		.ticks = static_cast<int>(options.integer("ticks", 200)),
+		.warmup = static_cast<int>(options.integer("warmup", 20)),
+		.churn = options.real("churn", 1.0),
+		.rewire = options.real("rewire", 1.0),
+		.relocate = static_cast<int>(options.integer("relocate", 50)),
+		.seed = static_cast<unsigned int>(options.integer("seed", 1))
+	};
+
+	std::cout << "Zombie benchmark\n"
+		<< "Entities: " << config.entities
+		<< ", listeners per signal: " << config.listeners
+		<< ", ticks: " << config.ticks
+		<< ", churn: " << config.churn << "%"
+		<< ", rewire: " << config.rewire << "%"
+		<< ", relocate every: " << config.relocate << " ticks\n";
+
+	const auto setupStart = benchmark::Clock::now();
+	const auto setupAllocations = benchmark::allocations();
+	Simulation simulation{config};
+	const auto setupTime = benchmark::Clock::now() - setupStart;
+	const auto setupAllocated = benchmark::allocations() - setupAllocations;
+
+	for (int i = 0; i < config.warmup; ++i) {
+		simulation.tick(i);
+	}
+
+	std::vector<benchmark::Clock::duration> tickTimes;
+	tickTimes.reserve(config.ticks);
+	long long emissions = 0;
+	const auto slotCallsBefore = simulation.stats().slotCalls();
+	const auto tickAllocations = benchmark::allocations();
+	const auto start = benchmark::Clock::now();
+	for (int i = 0; i < config.ticks; ++i) {
+		const auto tickStart = benchmark::Clock::now();
+		emissions += simulation.tick(config.warmup + i);
+		tickTimes.push_back(benchmark::Clock::now() - tickStart);
+	}
+	const auto totalTime = benchmark::Clock::now() - start;
+	const auto tickAllocated = benchmark::allocations() - tickAllocations;
+	const auto slotCalls = simulation.stats().slotCalls() - slotCallsBefore;
+
+	const auto seconds = benchmark::seconds(totalTime);
+	const auto ticks = std::max(config.ticks, 1);
+	std::cout << "Setup: " << benchmark::seconds(setupTime) << " s, "
+		<< setupAllocated.count << " allocations, " << setupAllocated.bytes << " bytes\n"
+		<< "Emissions: " << emissions << " (" << static_cast<double>(emissions) / seconds / 1e6 << " M/s)\n"
+		<< "Slot calls: " << slotCalls << " (" << static_cast<double>(slotCalls) / seconds / 1e6 << " M/s)\n"
+		<< "Tick latency: p50 " << benchmark::microseconds(benchmark::percentile(tickTimes, 50.0)) << " us"
+		<< ", p99 " << benchmark::microseconds(benchmark::percentile(tickTimes, 99.0)) << " us"
+		<< ", max " << benchmark::microseconds(benchmark::percentile(tickTimes, 100.0)) << " us\n"
+		<< "Allocations per tick: " << tickAllocated.count / ticks << ", "
+		<< tickAllocated.bytes / ticks << " bytes\n"
+		<< "Peak RSS: " << benchmark::peakRss() / (1024 * 1024) << " MB\n"
+		<< "Entities alive: " << simulation.size() << "\n";
+
+	return 0;
+}
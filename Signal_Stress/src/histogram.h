@@ -0,0 +1,75 @@
+#ifndef SIGNAL_STRESS_HISTOGRAM_H
+#define SIGNAL_STRESS_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace stress {
+
+	/// @brief Latency histogram with power of two nanosecond buckets. Owned by one thread,
+	/// recording does not allocate.
+	class Histogram {
+	public:
+		static constexpr int Buckets = 40;
+
+		void record(std::chrono::nanoseconds duration) noexcept {
+			const auto ns = static_cast<std::uint64_t>(std::max<std::int64_t>(duration.count(), 0));
+			++buckets_[std::min<int>(std::bit_width(ns), Buckets - 1)];
+			++count_;
+			max_ = std::max(max_, ns);
+		}
+
+		void merge(const Histogram& histogram) noexcept {
+			for (int i = 0; i < Buckets; ++i) {
+				buckets_[i] += histogram.buckets_[i];
+			}
+			count_ += histogram.count_;
+			max_ = std::max(max_, histogram.max_);
+		}
+
+		std::uint64_t count() const noexcept {
+			return count_;
+		}
+
+		std::uint64_t max() const noexcept {
+			return max_;
+		}
+
+		/// @brief Return the upper bound in nanoseconds of the bucket holding the percentile.
+		std::uint64_t percentile(double percent) const noexcept {
+			if (count_ == 0) {
+				return 0;
+			}
+			const auto target = static_cast<std::uint64_t>(percent / 100.0 * static_cast<double>(count_ - 1)) + 1;
+			std::uint64_t seen = 0;
+			for (int i = 0; i < Buckets; ++i) {
+				seen += buckets_[i];
+				if (seen >= target) {
+					return std::uint64_t{1} << i;
+				}
+			}
+			return max_;
+		}
+
+		/// @brief Writes the non-empty buckets as "<=bound: count" lines.
+		void print(std::ostream& out, const char* indent) const {
+			for (int i = 0; i < Buckets; ++i) {
+				if (buckets_[i] > 0) {
+					out << indent << "<=" << (std::uint64_t{1} << i) << " ns: " << buckets_[i] << "\n";
+				}
+			}
+		}
+
+	private:
+		std::array<std::uint64_t, Buckets> buckets_{};
+		std::uint64_t count_ = 0;
+		std::uint64_t max_ = 0;
+	};
+
+}
+
+#endif
@@ -0,0 +1,408 @@
+#include "histogram.h"
+
+#include <mw/realtimesignal.h>
+#include <mw/shardedsignal.h>
+#include <mw/signal.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Randomized concurrent schedules of connect, emit, disconnect, clear and move on the signals
+// usable from several threads, checking invariants and recording per thread operation latency.
+// Returns non-zero if an invariant is broken. Build with -DSignal_Stress_TSAN=1 to run under
+// ThreadSanitizer.
+//
+// Options (--name=value):
+//   --mode        signal, realtime, sharded or all, default all
+//   --threads     number of threads, default 8
+//   --seconds     run time per mode, default 2
+//   --seed        random seed, default 1
+//   --histograms  print the latency histograms
+
+namespace {
+
+	using Clock = std::chrono::steady_clock;
+
+	enum Operation {
+		Connect,
+		Disconnect,
+		Emit,
+		Clear,
+		Move,
+		Operations
+	};
+
+	constexpr std::array<const char*, Operations> OperationNames{"connect", "disconnect", "emit", "clear", "move"};
+
+	struct Config {
+		int threads = 8;
+		std::chrono::milliseconds duration{2000};
+		std::uint64_t seed = 1;
+		bool histograms = false;
+	};
+
+	struct ThreadStats {
+		std::array<stress::Histogram, Operations> latencies;
+	};
+
+	// Orders emissions and disconnects. An emission is given the tick taken before it starts.
+	std::atomic<std::uint64_t> ticks{1};
+	std::atomic<long long> calls{0};
+	std::atomic<long long> violations{0};
+
+	void violation(const char* message) {
+		if (violations.fetch_add(1) < 10) {
+			std::cerr << "Invariant broken: " << message << "\n";
+		}
+	}
+
+	struct Listener {
+		std::atomic<std::uint64_t> disconnectedAt{0}; // The tick after disconnect returned, 0 before.
+
+		// Only used by slots disconnecting themselves, which are owned by no thread. Set before
+		// published is, and never changed after, so every emitter may disconnect it concurrently.
+		mw::signals::Connection connection;
+		std::atomic<bool> published{false};
+	};
+
+	using ListenerPtr = std::shared_ptr<Listener>;
+
+	// Checks that the slot is not called by an emission started after its disconnect returned.
+	void checkCall(const Listener& listener, std::uint64_t emittedAt) {
+		calls.fetch_add(1, std::memory_order_relaxed);
+		const auto disconnectedAt = listener.disconnectedAt.load(std::memory_order_acquire);
+		if (disconnectedAt != 0 && emittedAt > disconnectedAt) {
+			violation("slot called by an emission started after disconnect() returned");
+		}
+	}
+
+	auto makeSlot(ListenerPtr listener) {
+		return [listener = std::move(listener)](std::uint64_t emittedAt) {
+			checkCall(*listener, emittedAt);
+		};
+	}
+
+	void disconnect(mw::signals::Connection& connection, Listener& listener) {
+		connection.disconnect();
+		// Copies may be disconnected by several threads at once, the first tick stored is kept.
+		std::uint64_t unset = 0;
+		listener.disconnectedAt.compare_exchange_strong(unset, ticks.fetch_add(1), std::memory_order_release, std::memory_order_relaxed);
+	}
+
+	template <typename Function>
+	void timed(ThreadStats& stats, Operation operation, Function&& function) {
+		const auto start = Clock::now();
+		function();
+		stats.latencies[operation].record(Clock::now() - start);
+	}
+
+	struct Owned {
+		mw::signals::Connection connection;
+		ListenerPtr listener;
+	};
+
+	// Connections handed over from one thread to be disconnected by another.
+	class Mailbox {
+	public:
+		void post(Owned owned) {
+			std::scoped_lock lock{mutex_};
+			owned_.push_back(std::move(owned));
+		}
+
+		bool take(Owned& owned) {
+			std::scoped_lock lock{mutex_};
+			if (owned_.empty()) {
+				return false;
+			}
+			owned = std::move(owned_.back());
+			owned_.pop_back();
+			return true;
+		}
+
+	private:
+		std::mutex mutex_;
+		std::vector<Owned> owned_;
+	};
+
+	template <typename Work>
+	std::vector<ThreadStats> runThreads(const Config& config, Work work) {
+		std::vector<ThreadStats> stats(config.threads);
+		std::vector<std::thread> threads;
+		const auto deadline = Clock::now() + config.duration;
+		for (int i = 0; i < config.threads; ++i) {
+			threads.emplace_back([&, i]() {
+				std::mt19937_64 random{config.seed * 1000 + i};
+				work(i, random, stats[i], deadline);
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		return stats;
+	}
+
+	// ShardedSignal, all threads connect, emit and disconnect, also each other's connections
+	// and slots disconnecting themselves.
+	void stressSharded(const Config& config, std::vector<ThreadStats>& stats) {
+		mw::ShardedSignal<std::uint64_t> signal;
+		Mailbox mailbox;
+
+		stats = runThreads(config, [&](int, std::mt19937_64& random, ThreadStats& threadStats, Clock::time_point deadline) {
+			std::vector<Owned> owned;
+			auto disconnectOwned = [&](std::size_t index) {
+				timed(threadStats, Disconnect, [&]() {
+					disconnect(owned[index].connection, *owned[index].listener);
+				});
+				owned[index] = std::move(owned.back());
+				owned.pop_back();
+			};
+
+			while (Clock::now() < deadline) {
+				const auto r = random() % 100;
+				if (r < 25 && owned.size() < 64) {
+					auto listener = std::make_shared<Listener>();
+					timed(threadStats, Connect, [&]() {
+						owned.push_back({signal.connect(makeSlot(listener)), listener});
+					});
+				} else if (r < 30) {
+					// Disconnects itself when called, from whatever thread emits.
+					// Not serialized, emitters calling it at the same time disconnect the same connection.
+					auto listener = std::make_shared<Listener>();
+					timed(threadStats, Connect, [&]() {
+						listener->connection = signal.connect([listener](std::uint64_t emittedAt) {
+							checkCall(*listener, emittedAt);
+							if (listener->published.load(std::memory_order_acquire)) {
+								disconnect(listener->connection, *listener);
+							}
+						});
+					});
+					listener->published.store(true, std::memory_order_release);
+				} else if (r < 50 && !owned.empty()) {
+					disconnectOwned(random() % owned.size());
+				} else if (r < 55 && !owned.empty()) {
+					const auto index = random() % owned.size();
+					mailbox.post(std::move(owned[index]));
+					owned[index] = std::move(owned.back());
+					owned.pop_back();
+				} else if (r < 60) {
+					Owned taken;
+					if (mailbox.take(taken)) {
+						timed(threadStats, Disconnect, [&]() {
+							disconnect(taken.connection, *taken.listener);
+						});
+					}
+				} else {
+					timed(threadStats, Emit, [&]() {
+						signal(ticks.fetch_add(1));
+					});
+				}
+			}
+			while (!owned.empty()) {
+				disconnectOwned(owned.size() - 1);
+			}
+		});
+
+		Owned taken;
+		while (mailbox.take(taken)) {
+			disconnect(taken.connection, *taken.listener);
+		}
+		// Only self disconnecting slots not yet called remain.
+		signal.clear();
+		if (!signal.empty()) {
+			violation("sharded signal not empty after clear");
+		}
+	}
+
+	// RealtimeSignal, one emitting thread and the other threads connect and disconnect.
+	void stressRealtime(const Config& config, std::vector<ThreadStats>& stats) {
+		mw::RealtimeSignal<std::uint64_t> signal;
+
+		stats = runThreads(config, [&](int index, std::mt19937_64& random, ThreadStats& threadStats, Clock::time_point deadline) {
+			if (index == 0) {
+				while (Clock::now() < deadline) {
+					timed(threadStats, Emit, [&]() {
+						signal(ticks.fetch_add(1));
+					});
+				}
+				return;
+			}
+			std::vector<Owned> owned;
+			while (Clock::now() < deadline) {
+				const auto r = random() % 100;
+				if (r < 50 && owned.size() < 64) {
+					auto listener = std::make_shared<Listener>();
+					timed(threadStats, Connect, [&]() {
+						owned.push_back({signal.connect(makeSlot(listener)), listener});
+					});
+				} else if (!owned.empty()) {
+					const auto i = random() % owned.size();
+					timed(threadStats, Disconnect, [&]() {
+						disconnect(owned[i].connection, *owned[i].listener);
+					});
+					owned[i] = std::move(owned.back());
+					owned.pop_back();
+				}
+			}
+			for (auto& [connection, listener] : owned) {
+				disconnect(connection, *listener);
+			}
+		});
+
+		if (!signal.empty()) {
+			violation("realtime signal not empty after all disconnects");
+		}
+	}
+
+	// Two Signals behind one lock, connect, emit, disconnect, clear and move assign between them.
+	// Checks that connections follow the moves and that disconnected slots are never called.
+	void stressSignal(const Config& config, std::vector<ThreadStats>& stats) {
+		struct Tracked {
+			mw::signals::Connection connection;
+			std::shared_ptr<bool> connected;
+		};
+
+		std::mutex mutex;
+		std::array<mw::Signal<std::uint64_t>, 2> signals;
+		std::vector<Tracked> tracked;
+
+		auto connectedCount = [&]() {
+			int count = 0;
+			for (auto& t : tracked) {
+				count += t.connection.connected();
+			}
+			return count;
+		};
+
+		stats = runThreads(config, [&](int, std::mt19937_64& random, ThreadStats& threadStats, Clock::time_point deadline) {
+			while (Clock::now() < deadline) {
+				const auto r = random() % 100;
+				const auto s = random() % 2;
+				std::scoped_lock lock{mutex};
+				if (r < 35 && tracked.size() < 128) {
+					auto connected = std::make_shared<bool>(true);
+					timed(threadStats, Connect, [&]() {
+						tracked.push_back({signals[s].connect([connected](std::uint64_t) {
+							calls.fetch_add(1, std::memory_order_relaxed);
+							if (!*connected) {
+								violation("disconnected slot called");
+							}
+						}), connected});
+					});
+				} else if (r < 60 && !tracked.empty()) {
+					const auto i = random() % tracked.size();
+					timed(threadStats, Disconnect, [&]() {
+						tracked[i].connection.disconnect();
+					});
+					*tracked[i].connected = false;
+					tracked[i] = std::move(tracked.back());
+					tracked.pop_back();
+				} else if (r < 63) {
+					timed(threadStats, Clear, [&]() {
+						signals[s].clear();
+					});
+				} else if (r < 66) {
+					timed(threadStats, Move, [&]() {
+						signals[s] = std::move(signals[1 - s]);
+					});
+				} else {
+					timed(threadStats, Emit, [&]() {
+						signals[s](ticks.fetch_add(1));
+					});
+				}
+				// Slots removed by clear and move assignment are no longer connected.
+				std::erase_if(tracked, [](Tracked& t) {
+					if (!t.connection.connected()) {
+						*t.connected = false;
+						return true;
+					}
+					return false;
+				});
+				if (signals[0].size() + signals[1].size() != connectedCount()) {
+					violation("signal sizes differ from the connected connections");
+				}
+			}
+		});
+	}
+
+	void report(const char* mode, const Config& config, const std::vector<ThreadStats>& stats) {
+		std::cout << "Mode " << mode << ", threads: " << config.threads << "\n";
+		std::array<stress::Histogram, Operations> total;
+		for (std::size_t i = 0; i < stats.size(); ++i) {
+			std::cout << "  Thread " << i << ":";
+			for (int op = 0; op < Operations; ++op) {
+				const auto& histogram = stats[i].latencies[op];
+				total[op].merge(histogram);
+				if (histogram.count() > 0) {
+					std::cout << " " << OperationNames[op] << " " << histogram.count()
+						<< " (p50 " << histogram.percentile(50.0)
+						<< " ns, p99 " << histogram.percentile(99.0)
+						<< " ns, max " << histogram.max() << " ns)";
+				}
+			}
+			std::cout << "\n";
+		}
+		if (config.histograms) {
+			for (int op = 0; op < Operations; ++op) {
+				if (total[op].count() > 0) {
+					std::cout << "  " << OperationNames[op] << " latency, all threads:\n";
+					total[op].print(std::cout, "    ");
+				}
+			}
+		}
+	}
+
+}
+
+int main(int argc, char** argv) {
+	Config config;
+	std::string mode = "all";
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg = argv[i];
+		const auto equal = arg.find('=');
+		const auto name = arg.substr(0, equal);
+		const auto value = equal == std::string_view::npos ? std::string{} : std::string{arg.substr(equal + 1)};
+		if (name == "--mode") {
+			mode = value;
+		} else if (name == "--threads") {
+			config.threads = std::max(std::atoi(value.c_str()), 2);
+		} else if (name == "--seconds") {
+			config.duration = std::chrono::milliseconds{static_cast<long long>(std::atof(value.c_str()) * 1000)};
+		} else if (name == "--seed") {
+			config.seed = std::strtoull(value.c_str(), nullptr, 10);
+		} else if (name == "--histograms") {
+			config.histograms = true;
+		} else {
+			std::cerr << "Unknown argument: " << arg << "\n";
+			return 2;
+		}
+	}
+
+	std::cout << "Signal stress, seed: " << config.seed << "\n";
+	std::vector<ThreadStats> stats;
+	if (mode == "all" || mode == "signal") {
+		stressSignal(config, stats);
+		report("signal", config, stats);
+	}
+	if (mode == "all" || mode == "realtime") {
+		stressRealtime(config, stats);
+		report("realtime", config, stats);
+	}
+	if (mode == "all" || mode == "sharded") {
+		stressSharded(config, stats);
+		report("sharded", config, stats);
+	}
+
+	std::cout << "Slot calls: " << calls << ", invariants broken: " << violations << "\n";
+	return violations == 0 ? 0 : 1;
+}
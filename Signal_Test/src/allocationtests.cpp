@@ -0,0 +1,404 @@
+#include <mw/signal.h>
+#include <mw/arenasignal.h>
+#include <mw/compactsignal.h>
+#include <mw/payload.h>
+#include <mw/realtimesignal.h>
+#include <mw/shardedsignal.h>
+#include <mw/timedsignal.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+// Counts all allocations made by the test program, to prove that invoke does not allocate.
+
+namespace {
+
+	std::atomic<long long> allocations{0};
+
+	void* allocate(std::size_t size) {
+		allocations.fetch_add(1, std::memory_order_relaxed);
+		if (auto ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) {
+			return ptr;
+		}
+		throw std::bad_alloc{};
+	}
+
+}
+
+void* operator new(std::size_t size) {
+	return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+	return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+class AllocationTest : public ::testing::Test {
+protected:
+
+	AllocationTest() {
+	}
+
+	~AllocationTest() override {
+	}
+
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+		mw::signals::setAllocationHook(nullptr);
+	}
+
+	template <typename Function>
+	static long long countAllocations(Function&& function) {
+		const auto before = allocations.load();
+		function();
+		return allocations.load() - before;
+	}
+};
+
+namespace {
+
+	int freeFunctionSum = 0;
+
+	void freeFunction(int value) {
+		freeFunctionSum += value;
+	}
+
+	struct Listener {
+		void onValue(int value) {
+			sum += value;
+		}
+
+		int sum = 0;
+	};
+
+	struct HookCalls {
+		const void* signal = nullptr;
+		int calls = 0;
+		std::size_t bytes = 0;
+	};
+
+	HookCalls hookCalls;
+
+	std::vector<const void*> hookSignals;
+
+	void recordSignal(const void* signal, std::size_t) {
+		hookSignals.push_back(signal);
+	}
+
+	bool reported(const void* signal) {
+		return std::find(hookSignals.begin(), hookSignals.end(), signal) != hookSignals.end();
+	}
+
+}
+
+TEST_F(AllocationTest, commonSlotShapes_whenInvoked_thenNothingIsAllocated) {
+	// Given.
+	int sum = 0;
+	Listener listener;
+	std::array<int, 32> large{};
+	large[0] = 1;
+	mw::Signal<int> signal;
+	mw::signals::ScopedConnections connections;
+	connections += {
+		signal.connect([&sum](int value) {
+			sum += value;
+		}),
+		signal.connect(&listener, &Listener::onValue),
+		signal.connect(&freeFunction),
+		signal.connect(mw::Signal<int>::Callback{[&sum](int value) {
+			sum += value;
+		}}),
+		signal.connect([&sum, large](int value) {
+			sum += large[0] * value;
+		}),
+		signal.connectBatch([&sum](std::span<const std::tuple<int>> events) {
+			sum += static_cast<int>(events.size());
+		})
+	};
+
+	// When.
+	auto count = countAllocations([&]() {
+		signal(1);
+		signal.invoke(2);
+	});
+
+	// Then.
+	EXPECT_EQ(0, count);
+	EXPECT_EQ(3 * 3 + 2, sum);
+	EXPECT_EQ(3, listener.sum);
+}
+
+TEST_F(AllocationTest, referenceArgumentsForwardsAndBatches_whenInvoked_thenNothingIsAllocated) {
+	// Given.
+	std::size_t length = 0;
+	mw::Signal<const std::string&> signal;
+	mw::Signal<const std::string&> target;
+	mw::signals::ScopedConnections connections;
+	connections += {
+		signal.connect([&length](const std::string& text) {
+			length += text.size();
+		}),
+		target.connect([&length](const std::string& text) {
+			length += text.size();
+		}),
+		signal.forwardTo(target)
+	};
+	const std::string text(100, 'x');
+	const std::array<mw::Signal<const std::string&>::Event, 2> events{{{text}, {text}}};
+
+	// When.
+	auto count = countAllocations([&]() {
+		signal(text);
+		signal.invokeBatch(events);
+		signal.invokeWith([&text]() -> const std::string& {
+			return text;
+		});
+	});
+
+	// Then.
+	EXPECT_EQ(0, count);
+	EXPECT_EQ(2 * 4 * text.size(), length);
+}
+
+TEST_F(AllocationTest, disconnectingDuringInvoke_thenNothingIsAllocated) {
+	// Given.
+	mw::Signal<> signal;
+	mw::signals::Connection c1;
+	mw::signals::Connection c2 = signal.connect([]() {});
+	c1 = signal.connect([&]() {
+		c1.disconnect();
+		c2.disconnect();
+	});
+
+	// When.
+	auto count = countAllocations([&]() {
+		signal();
+	});
+
+	// Then.
+	EXPECT_EQ(0, count);
+	EXPECT_TRUE(signal.empty());
+}
+
+TEST_F(AllocationTest, reserved_whenConnecting_thenOnlyKeysAreAllocated) {
+	// Given.
+	const int Slots = 100;
+	mw::Signal<int> signal;
+	mw::signals::ScopedConnections connections;
+	signal.reserve(Slots);
+	connections.reserve(Slots);
+	const auto reserved = signal.allocationStats();
+
+	// When.
+	auto count = countAllocations([&]() {
+		for (int i = 0; i < Slots; ++i) {
+			connections += signal.connect([](int) {});
+		}
+	});
+
+	// Then.
+	EXPECT_EQ(Slots, count);
+	EXPECT_EQ(reserved.count + Slots, signal.allocationStats().count);
+}
+
+TEST_F(AllocationTest, largeCallable_whenConnected_thenItsAllocationIsCounted) {
+	// Given.
+	std::array<char, 256> large{};
+	mw::Signal<> signal;
+	const auto before = signal.allocationStats();
+
+	// When.
+	[[maybe_unused]] auto connection = signal.connect([large]() {});
+
+	// Then.
+	EXPECT_LT(before.count + 1, signal.allocationStats().count);
+	EXPECT_LE(before.bytes + sizeof(large), signal.allocationStats().bytes);
+}
+
+TEST_F(AllocationTest, hookInstalled_whenConnecting_thenHookIsCalledWithSignal) {
+	// Given.
+	hookCalls = {};
+	mw::signals::setAllocationHook([](const void* signal, std::size_t bytes) {
+		hookCalls.signal = signal;
+		++hookCalls.calls;
+		hookCalls.bytes += bytes;
+	});
+	mw::Signal<int> signal;
+
+	// When.
+	[[maybe_unused]] auto connection = signal.connect([](int) {});
+	mw::signals::setAllocationHook(nullptr);
+	[[maybe_unused]] auto other = signal.connect([](int) {});
+
+	// Then.
+	EXPECT_EQ(&signal, hookCalls.signal);
+	EXPECT_EQ(hookCalls.calls + 1, signal.allocationStats().count);
+	EXPECT_LT(hookCalls.bytes, signal.allocationStats().bytes);
+}
+
+TEST_F(AllocationTest, disconnectedSlots_whenShrunk_thenMemoryIsReleased) {
+	// Given.
+	mw::Signal<int> signal;
+	mw::signals::ScopedConnections connections;
+	for (int i = 0; i < 100; ++i) {
+		connections += signal.connect([](int) {});
+	}
+	connections.clear();
+	const auto memory = signal.memoryUsage();
+	mw::Signal<int> unused;
+	unused.shrink_to_fit();
+
+	// When.
+	signal.shrink_to_fit();
+	connections.shrink_to_fit();
+
+	// Then.
+	EXPECT_GT(memory, signal.memoryUsage());
+	EXPECT_EQ(unused.memoryUsage(), signal.memoryUsage());
+}
+
+TEST_F(AllocationTest, hookInstalled_whenConnectingToOtherSignals_thenEachSignalIsReported) {
+	// Given.
+	mw::ArenaSignal<int> arenaSignal;
+	mw::CompactSignal<int> compactSignal;
+	mw::RealtimeSignal<int> realtimeSignal;
+	mw::ShardedSignal<int> shardedSignal{2};
+	mw::signals::ScopedConnections connections;
+	connections.reserve(4);
+	hookSignals.clear();
+	mw::signals::setAllocationHook(&recordSignal);
+
+	// When.
+	connections += arenaSignal.connect([](int) {});
+	connections += compactSignal.connect([](int) {});
+	connections += realtimeSignal.connect([](int) {});
+	connections += shardedSignal.connect([](int) {});
+
+	// Then.
+	EXPECT_TRUE(reported(&arenaSignal));
+	EXPECT_TRUE(reported(&compactSignal));
+	EXPECT_TRUE(reported(&realtimeSignal));
+	EXPECT_TRUE(reported(&shardedSignal));
+}
+
+TEST_F(AllocationTest, hookInstalled_whenScopedConnectionsAndTimerWheelGrow_thenAllocationsAreReported) {
+	// Given.
+	mw::signals::TimerWheel wheel;
+	mw::signals::ScopedConnections connections;
+	hookSignals.clear();
+	mw::signals::setAllocationHook(&recordSignal);
+
+	// When.
+	connections.reserve(10);
+	const auto reservedCalls = hookSignals.size();
+	wheel.schedule(std::chrono::milliseconds{1}, []() {});
+
+	// Then.
+	EXPECT_EQ(1, reservedCalls);
+	EXPECT_LT(reservedCalls, hookSignals.size());
+	EXPECT_TRUE(std::all_of(hookSignals.begin(), hookSignals.end(), [](const void* signal) {
+		return signal == nullptr;
+	}));
+}
+
+TEST_F(AllocationTest, debouncedInvoke_whenRearmed_thenNothingIsAllocated) {
+	// Given.
+	mw::signals::TimerWheel wheel;
+	mw::TimedSignal<int> signal{wheel};
+	signal.setDebounce(std::chrono::milliseconds{10});
+	int value = 0;
+	mw::signals::ScopedConnection connection = signal.connect([&value](int newValue) {
+		value = newValue;
+	});
+	// A first emission grows the timer wheel's node pool.
+	signal(1);
+	wheel.advance(std::chrono::milliseconds{10});
+
+	// When.
+	auto count = countAllocations([&]() {
+		for (int i = 2; i <= 10; ++i) {
+			signal(i);
+			wheel.advance(std::chrono::milliseconds{5});
+		}
+		wheel.advance(std::chrono::milliseconds{10});
+	});
+
+	// Then.
+	EXPECT_EQ(0, count);
+	EXPECT_EQ(10, value);
+}
+
+TEST_F(AllocationTest, hookInstalled_whenPayloadPoolGrows_thenAllocationsAreReported) {
+	// Given.
+	hookSignals.clear();
+	mw::signals::setAllocationHook(&recordSignal);
+
+	// When.
+	mw::PayloadPool<int> pool;
+	const auto poolCalls = hookSignals.size();
+	auto payload = pool.acquire([](int& value) {
+		value = 1;
+	});
+	const auto nodeCalls = hookSignals.size();
+	pool.reserve(4);
+
+	// Then.
+	EXPECT_EQ(1, poolCalls);
+	EXPECT_EQ(poolCalls + 1, nodeCalls);
+	EXPECT_LT(nodeCalls, hookSignals.size());
+	EXPECT_TRUE(std::all_of(hookSignals.begin(), hookSignals.end(), [](const void* signal) {
+		return signal == nullptr;
+	}));
+}
+
+TEST_F(AllocationTest, pooledPayload_whenReusedThroughSignal_thenNothingIsAllocated) {
+	// Given.
+	mw::PayloadPool<std::vector<int>> pool;
+	pool.reserve(2);
+	mw::Signal<mw::Payload<std::vector<int>>> signal;
+	std::size_t sum = 0;
+	mw::signals::ScopedConnection connection = signal.connect([&sum](const mw::Payload<std::vector<int>>& payload) {
+		sum += payload->size();
+	});
+	auto fill = [](std::vector<int>& values) {
+		values.assign(100, 1);
+	};
+	// A first emission grows the pooled vector to its final capacity.
+	signal(pool.acquire(fill));
+
+	// When.
+	auto count = countAllocations([&]() {
+		for (int i = 0; i < 10; ++i) {
+			signal(pool.acquire(fill));
+		}
+	});
+
+	// Then.
+	EXPECT_EQ(0, count);
+	EXPECT_EQ(1100, sum);
+}
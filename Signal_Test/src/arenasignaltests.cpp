@@ -0,0 +1,306 @@
+#include <mw/arenasignal.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <stdexcept>
+
+class ArenaSignalTest : public ::testing::Test {
+protected:
+
+	ArenaSignalTest() {
+	}
+
+	~ArenaSignalTest() override {
+	}
+
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+namespace {
+
+	struct Counted {
+		Counted(int& alive)
+			: alive_{&alive} {
+			++*alive_;
+		}
+
+		Counted(const Counted& counted)
+			: alive_{counted.alive_} {
+			++*alive_;
+		}
+
+		Counted(Counted&& counted) noexcept
+			: alive_{counted.alive_} {
+			++*alive_;
+		}
+
+		~Counted() {
+			--*alive_;
+		}
+
+		void operator()(int) const {
+		}
+
+		int* alive_;
+	};
+
+}
+
+TEST_F(ArenaSignalTest, connectionsAdded_whenInvoked_thenAllCalledInOrder) {
+	// Given.
+	mw::ArenaSignal<int> signal;
+	std::vector<int> order;
+	mw::signals::ScopedConnections connections;
+	for (int i = 0; i < 1000; ++i) {
+		connections += signal.connect([&order, i](int value) {
+			order.push_back(i + value);
+		});
+	}
+	EXPECT_EQ(1000, signal.size());
+
+	// When.
+	signal(1);
+
+	// Then.
+	ASSERT_EQ(1000, order.size());
+	for (int i = 0; i < 1000; ++i) {
+		EXPECT_EQ(i + 1, order[i]);
+	}
+}
+
+TEST_F(ArenaSignalTest, disconnectingMost_thenCompactedSlotsKeepStateAndOrder) {
+	// Given.
+	mw::ArenaSignal<> signal;
+	std::vector<int> order;
+	std::vector<mw::signals::Connection> connections;
+	for (int i = 0; i < 100; ++i) {
+		connections.push_back(signal.connect([&order, i, padding = std::array<char, 100>{}]() {
+			order.push_back(i);
+		}));
+	}
+
+	// When.
+	for (int i = 0; i < 100; ++i) {
+		if (i % 10 != 0) {
+			connections[i].disconnect();
+		}
+	}
+	signal();
+
+	// Then.
+	EXPECT_EQ(10, signal.size());
+	EXPECT_EQ((std::vector<int>{0, 10, 20, 30, 40, 50, 60, 70, 80, 90}), order);
+}
+
+TEST_F(ArenaSignalTest, callablesStoredByValue_thenDestroyedOnDisconnectAndClear) {
+	// Given.
+	int alive = 0;
+	mw::ArenaSignal<int> signal;
+	auto c1 = signal.connect(Counted{alive});
+	[[maybe_unused]] auto c2 = signal.connect(Counted{alive});
+	EXPECT_EQ(2, alive);
+
+	// When.
+	c1.disconnect();
+
+	// Then.
+	EXPECT_EQ(1, alive);
+
+	// When.
+	signal.clear();
+
+	// Then.
+	EXPECT_EQ(0, alive);
+	EXPECT_TRUE(signal.empty());
+}
+
+TEST_F(ArenaSignalTest, moveOnlyCallable_whenInvoked_thenCalled) {
+	// Given.
+	int value = 0;
+	mw::ArenaSignal<int> signal;
+	auto connection = signal.connect([ptr = std::make_unique<int>(3), &value](int x) {
+		value = *ptr * x;
+	});
+
+	// When.
+	signal(2);
+
+	// Then.
+	EXPECT_EQ(6, value);
+}
+
+TEST_F(ArenaSignalTest, disconnectingDuringInvoke_thenDisconnectedCallbackIsNotInvoked) {
+	// Given.
+	mw::ArenaSignal<> signal;
+	mw::signals::Connection c2;
+	mw::signals::Connection c1 = signal.connect([&]() {
+		c1.disconnect();
+		c2.disconnect();
+	});
+	c2 = signal.connect([]() {
+		FAIL();
+	});
+
+	// When.
+	signal.invoke();
+
+	// Then.
+	EXPECT_TRUE(signal.empty());
+	EXPECT_FALSE(c1.connected());
+}
+
+TEST_F(ArenaSignalTest, slotThrows_thenLaterDisconnectDestroysCallable) {
+	// Given.
+	int alive = 0;
+	mw::ArenaSignal<int> signal;
+	auto c1 = signal.connect([](int) {
+		throw std::runtime_error{"slot failed"};
+	});
+	auto c2 = signal.connect(Counted{alive});
+	EXPECT_THROW(signal(1), std::runtime_error);
+
+	// When.
+	c2.disconnect();
+
+	// Then.
+	EXPECT_EQ(0, alive);
+	EXPECT_EQ(1, signal.size());
+}
+
+TEST_F(ArenaSignalTest, moveAssignedDuringInvoke_thenReplacedSlotsAreDestroyedAfterInvoke) {
+	// Given.
+	int alive = 0;
+	int replacedCalls = 0;
+	int newCalls = 0;
+	mw::ArenaSignal<int> signal;
+	mw::ArenaSignal<int> other;
+	auto c1 = signal.connect([&, counted = Counted{alive}](int) {
+		signal = std::move(other);
+		EXPECT_EQ(2, alive); // Still executing.
+	});
+	auto c2 = signal.connect([&replacedCalls, counted = Counted{alive}](int) {
+		++replacedCalls;
+	});
+	auto c3 = other.connect([&newCalls](int) {
+		++newCalls;
+	});
+
+	// When.
+	signal(1);
+
+	// Then.
+	EXPECT_EQ(0, alive);
+	EXPECT_EQ(0, replacedCalls);
+	EXPECT_EQ(0, newCalls);
+	EXPECT_FALSE(c1.connected());
+	EXPECT_FALSE(c2.connected());
+
+	// When.
+	signal(2);
+
+	// Then.
+	EXPECT_EQ(1, newCalls);
+	EXPECT_EQ(1, signal.size());
+	EXPECT_TRUE(c3.connected());
+}
+
+TEST_F(ArenaSignalTest, movedFromDuringInvoke_thenInvokeEndsAndSlotsFollowTheSignal) {
+	// Given.
+	mw::ArenaSignal<int> signal;
+	std::unique_ptr<mw::ArenaSignal<int>> moved;
+	int calls = 0;
+	auto c1 = signal.connect([&](int) {
+		++calls;
+		moved = std::make_unique<mw::ArenaSignal<int>>(std::move(signal));
+	});
+	auto c2 = signal.connect([&calls](int) {
+		calls += 10;
+	});
+
+	// When.
+	signal(1);
+
+	// Then.
+	EXPECT_EQ(1, calls);
+	EXPECT_TRUE(signal.empty());
+	ASSERT_NE(nullptr, moved);
+	EXPECT_EQ(2, moved->size());
+
+	// When.
+	c1.disconnect();
+	(*moved)(1);
+
+	// Then.
+	EXPECT_EQ(11, calls);
+	EXPECT_TRUE(c2.connected());
+}
+
+TEST_F(ArenaSignalTest, connectingDuringInvoke_thenNewCallbackIsNotCalled) {
+	// Given.
+	mw::ArenaSignal<> signal;
+	int invoked = 0;
+	mw::signals::ScopedConnections connections;
+	connections += signal.connect([&]() {
+		++invoked;
+		for (int i = 0; i < 1000; ++i) {
+			connections += signal.connect([]() {});
+		}
+	});
+
+	// When.
+	signal.invoke();
+
+	// Then.
+	EXPECT_EQ(1, invoked);
+	EXPECT_EQ(1001, signal.size());
+}
+
+TEST_F(ArenaSignalTest, moveSignal_thenConnectionsFollow) {
+	// Given.
+	int nbr = 0;
+	mw::ArenaSignal<> signal;
+	auto connection = signal.connect([&nbr]() {
+		++nbr;
+	});
+
+	// When.
+	mw::ArenaSignal<> movedSignal = std::move(signal);
+	signal();
+	movedSignal();
+
+	// Then.
+	EXPECT_EQ(1, nbr);
+	EXPECT_TRUE(signal.empty());
+	EXPECT_EQ(1, movedSignal.size());
+
+	// When.
+	connection.disconnect();
+
+	// Then.
+	EXPECT_TRUE(movedSignal.empty());
+}
+
+TEST_F(ArenaSignalTest, connectMemberFunction_whenInvoked_thenMemberFunctionIsCalled) {
+	// Given.
+	struct Listener {
+		void onValue(int value) {
+			sum += value;
+		}
+		int sum = 0;
+	} listener;
+	mw::ArenaSignal<int> signal;
+	auto connection = signal.connect(&listener, &Listener::onValue);
+
+	// When.
+	signal(3);
+	signal(4);
+
+	// Then.
+	EXPECT_EQ(7, listener.sum);
+}
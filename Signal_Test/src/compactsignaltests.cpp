@@ -0,0 +1,291 @@
+#include <mw/compactsignal.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+class CompactSignalTest : public ::testing::Test {
+protected:
+
+	CompactSignalTest() {
+	}
+
+	~CompactSignalTest() override {
+	}
+
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+TEST_F(CompactSignalTest, newSignal_thenSizeOfPointerAndNoHeapUsage) {
+	// Given.
+	mw::CompactSignal<int> signal;
+
+	// Then.
+	static_assert(sizeof(mw::CompactSignal<int>) == sizeof(void*));
+	EXPECT_TRUE(signal.empty());
+	EXPECT_EQ(sizeof(void*), signal.memoryUsage());
+	EXPECT_LT(signal.memoryUsage(), mw::Signal<int>{}.memoryUsage());
+}
+
+TEST_F(CompactSignalTest, connectionsBeyondInlineSlots_whenInvoked_thenAllCalledInOrder) {
+	// Given.
+	mw::CompactSignal<int> signal;
+	std::vector<int> order;
+	mw::signals::ScopedConnections connections;
+	for (int i = 0; i < 5; ++i) {
+		connections += signal.connect([&order, i](int value) {
+			order.push_back(i * value);
+		});
+	}
+
+	// When.
+	signal(2);
+
+	// Then.
+	EXPECT_EQ(5, signal.size());
+	EXPECT_EQ((std::vector<int>{0, 2, 4, 6, 8}), order);
+}
+
+TEST_F(CompactSignalTest, disconnectingInlineSlot_thenOverflowSlotsMoveInlineAndOrderIsPreserved) {
+	// Given.
+	mw::CompactSignal<> signal;
+	std::vector<int> order;
+	std::vector<mw::signals::Connection> connections;
+	for (int i = 0; i < 4; ++i) {
+		connections.push_back(signal.connect([&order, i]() {
+			order.push_back(i);
+		}));
+	}
+
+	// When.
+	connections[0].disconnect();
+	connections[2].disconnect();
+	signal();
+
+	// Then.
+	EXPECT_EQ(2, signal.size());
+	EXPECT_EQ((std::vector<int>{1, 3}), order);
+}
+
+TEST_F(CompactSignalTest, disconnectingDuringInvoke_thenDisconnectedCallbackIsNotInvoked) {
+	// Given.
+	mw::CompactSignal<> signal;
+	mw::signals::Connection c2;
+	mw::signals::Connection c3;
+	[[maybe_unused]] auto c1 = signal.connect([&]() {
+		c2.disconnect();
+		c3.disconnect();
+	});
+	c2 = signal.connect([]() { FAIL(); });
+	c3 = signal.connect([]() { FAIL(); });
+
+	// When.
+	signal();
+
+	// Then.
+	EXPECT_EQ(1, signal.size());
+}
+
+TEST_F(CompactSignalTest, movedSignal_thenConnectionsFollowWithoutRepointing) {
+	// Given.
+	int invoked = 0;
+	mw::CompactSignal<> signal;
+	auto connection = signal.connect([&]() { ++invoked; });
+
+	// When.
+	mw::CompactSignal<> movedSignal = std::move(signal);
+	signal();
+	movedSignal();
+
+	// Then.
+	EXPECT_EQ(1, invoked);
+	EXPECT_TRUE(connection.connected());
+
+	// When.
+	connection.disconnect();
+
+	// Then.
+	EXPECT_TRUE(movedSignal.empty());
+}
+
+TEST_F(CompactSignalTest, clear_thenConnectionsDisconnectedAndStorageReleased) {
+	// Given.
+	mw::CompactSignal<> signal;
+	auto connection = signal.connect([]() {});
+
+	// When.
+	signal.clear();
+
+	// Then.
+	EXPECT_FALSE(connection.connected());
+	EXPECT_EQ(sizeof(void*), signal.memoryUsage());
+}
+
+TEST_F(CompactSignalTest, lastSlotDisconnected_thenStorageReleased) {
+	// Given.
+	mw::CompactSignal<int> signal;
+	auto c1 = signal.connect([](int) {});
+	auto c2 = signal.connect([](int) {});
+	auto c3 = signal.connect([](int) {});
+
+	// When.
+	mw::CompactSignal<int> movedSignal = std::move(signal);
+	c1.disconnect();
+	c2.disconnect();
+
+	// Then.
+	EXPECT_LT(sizeof(void*), movedSignal.memoryUsage());
+
+	// When.
+	c3.disconnect();
+
+	// Then.
+	EXPECT_TRUE(movedSignal.empty());
+	EXPECT_EQ(sizeof(void*), movedSignal.memoryUsage());
+}
+
+TEST_F(CompactSignalTest, lastSlotDisconnectedDuringInvoke_thenStorageReleasedAfterInvoke) {
+	// Given.
+	mw::CompactSignal<> signal;
+	mw::signals::Connection connection;
+	connection = signal.connect([&]() {
+		connection.disconnect();
+		EXPECT_LT(sizeof(void*), signal.memoryUsage());
+	});
+
+	// When.
+	signal();
+
+	// Then.
+	EXPECT_FALSE(connection.connected());
+	EXPECT_EQ(sizeof(void*), signal.memoryUsage());
+}
+
+TEST_F(CompactSignalTest, moveAssignedDuringInvoke_thenReplacedStorageIsDestroyedAfterInvoke) {
+	// Given.
+	mw::CompactSignal<int> signal;
+	mw::CompactSignal<int> other;
+	auto alive = std::make_shared<int>(1);
+	std::weak_ptr<int> watched = alive;
+	int replacedCalls = 0;
+	int newCalls = 0;
+	auto c1 = signal.connect([&, alive = std::move(alive)](int) {
+		signal = std::move(other);
+		EXPECT_EQ(1, *alive); // Still executing.
+	});
+	auto c2 = signal.connect([&replacedCalls](int) {
+		++replacedCalls;
+	});
+	auto c3 = other.connect([&newCalls](int) {
+		++newCalls;
+	});
+
+	// When.
+	signal(1);
+
+	// Then.
+	EXPECT_TRUE(watched.expired());
+	EXPECT_EQ(0, replacedCalls);
+	EXPECT_EQ(0, newCalls);
+	EXPECT_FALSE(c1.connected());
+	EXPECT_FALSE(c2.connected());
+
+	// When.
+	signal(2);
+
+	// Then.
+	EXPECT_EQ(1, newCalls);
+	EXPECT_EQ(1, signal.size());
+	EXPECT_TRUE(c3.connected());
+}
+
+TEST_F(CompactSignalTest, destroyedDuringInvoke_thenStorageIsDestroyedAfterInvoke) {
+	// Given.
+	auto signal = std::make_unique<mw::CompactSignal<>>();
+	int calls = 0;
+	auto c1 = signal->connect([&]() {
+		++calls;
+		signal = nullptr;
+	});
+	auto c2 = signal->connect([&calls]() {
+		calls += 10;
+	});
+
+	// When.
+	(*signal)();
+
+	// Then.
+	EXPECT_EQ(1, calls);
+	EXPECT_FALSE(c1.connected());
+	EXPECT_FALSE(c2.connected());
+}
+
+TEST_F(CompactSignalTest, slotThrows_thenLaterDisconnectsReleaseStorage) {
+	// Given.
+	mw::CompactSignal<> signal;
+	auto c1 = signal.connect([]() {
+		throw std::runtime_error{"slot"};
+	});
+	auto c2 = signal.connect([]() {});
+
+	// When.
+	EXPECT_THROW(signal(), std::runtime_error);
+	c1.disconnect();
+	c2.disconnect();
+
+	// Then.
+	EXPECT_TRUE(signal.empty());
+	EXPECT_EQ(sizeof(void*), signal.memoryUsage());
+}
+
+TEST_F(CompactSignalTest, slotDisconnectsAllAndThrows_thenStorageReleased) {
+	// Given.
+	mw::CompactSignal<> signal;
+	mw::signals::Connection connection;
+	connection = signal.connect([&]() {
+		connection.disconnect();
+		throw std::runtime_error{"slot"};
+	});
+
+	// When.
+	EXPECT_THROW(signal(), std::runtime_error);
+
+	// Then.
+	EXPECT_FALSE(connection.connected());
+	EXPECT_EQ(sizeof(void*), signal.memoryUsage());
+}
+
+namespace {
+
+	class Zombie {
+	public:
+		mw::PublicCompactSignal<Zombie, int> pointsUpdated;
+		mw::PublicCompactSignal<Zombie> died;
+
+		void kill() {
+			pointsUpdated(10);
+			died();
+		}
+	};
+
+}
+
+TEST_F(CompactSignalTest, publicCompactSignal_thenOwnerInvokes) {
+	// Given.
+	Zombie zombie;
+	int points = 0;
+	auto connection = zombie.pointsUpdated.connect([&](int value) { points = value; });
+
+	// When.
+	zombie.kill();
+
+	// Then.
+	EXPECT_EQ(10, points);
+	EXPECT_EQ(2 * sizeof(void*), sizeof(Zombie));
+}
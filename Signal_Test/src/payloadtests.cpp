@@ -0,0 +1,174 @@
+#include <mw/payload.h>
+#include <mw/signal.h>
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class PayloadTest : public ::testing::Test {
+protected:
+
+	PayloadTest() {
+	}
+
+	~PayloadTest() override {
+	}
+
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+namespace {
+
+	struct Frame {
+		std::vector<char> data;
+	};
+
+	void fillFrame(Frame& frame, char value) {
+		frame.data.assign(64 * 1024, value);
+	}
+
+}
+
+TEST_F(PayloadTest, lastHandleDestroyed_thenValueIsReusedByNextAcquire) {
+	// Given.
+	mw::PayloadPool<Frame> pool;
+	auto payload = pool.acquire([](Frame& frame) {
+		fillFrame(frame, 'a');
+	});
+	const auto address = &payload.get();
+	const auto buffer = payload->data.data();
+	auto copy = payload;
+	EXPECT_EQ(2, payload.useCount());
+
+	// When.
+	payload = {};
+	EXPECT_EQ(0, pool.available());
+	copy = {};
+
+	// Then.
+	EXPECT_EQ(1, pool.available());
+	auto reused = pool.acquire([](Frame& frame) {
+		fillFrame(frame, 'b');
+	});
+	EXPECT_EQ(address, &reused.get());
+	EXPECT_EQ(buffer, reused->data.data());
+	EXPECT_EQ('b', reused->data.back());
+}
+
+TEST_F(PayloadTest, signalOfPayload_whenInvoked_thenAllSlotsShareOneInstance) {
+	// Given.
+	mw::PayloadPool<Frame> pool;
+	mw::Signal<mw::Payload<Frame>> signal;
+	std::vector<const Frame*> received;
+	std::vector<mw::Payload<Frame>> deferred;
+	mw::signals::ScopedConnections connections;
+	connections += signal.connect([&](const Frame& frame) {
+		received.push_back(&frame);
+	});
+	connections += signal.connect([&](const mw::Payload<Frame>& payload) {
+		deferred.push_back(payload);
+	});
+	connections += signal.connect([&](mw::Payload<Frame> payload) {
+		deferred.push_back(std::move(payload));
+	});
+
+	// When.
+	signal(pool.acquire([](Frame& frame) {
+		fillFrame(frame, 'a');
+	}));
+
+	// Then.
+	ASSERT_EQ(1, received.size());
+	ASSERT_EQ(2, deferred.size());
+	EXPECT_EQ(received[0], &deferred[0].get());
+	EXPECT_EQ(received[0], &deferred[1].get());
+	EXPECT_EQ(0, pool.available());
+
+	// When.
+	deferred.clear();
+
+	// Then.
+	EXPECT_EQ(1, pool.available());
+}
+
+TEST_F(PayloadTest, deferredToThreads_whenAllDone_thenValuesAreBackInPool) {
+	// Given.
+	const int Threads = 4;
+	const int Events = 200;
+	mw::PayloadPool<Frame> pool;
+	pool.reserve(8);
+	mw::Signal<mw::Payload<Frame>> signal;
+	std::mutex mutex;
+	std::vector<std::vector<mw::Payload<Frame>>> queues(Threads);
+	mw::signals::ScopedConnections connections;
+	for (int i = 0; i < Threads; ++i) {
+		connections += signal.connect([&, i](mw::Payload<Frame> payload) {
+			std::scoped_lock lock{mutex};
+			queues[i].push_back(std::move(payload));
+		});
+	}
+
+	// When.
+	std::vector<long> sums(Threads);
+	std::vector<std::thread> threads;
+	for (int i = 0; i < Threads; ++i) {
+		threads.emplace_back([&, i]() {
+			int handled = 0;
+			while (handled < Events) {
+				std::vector<mw::Payload<Frame>> queue;
+				{
+					std::scoped_lock lock{mutex};
+					queue.swap(queues[i]);
+				}
+				for (const auto& payload : queue) {
+					sums[i] += payload->data.front();
+					++handled;
+				}
+			}
+		});
+	}
+	for (int i = 0; i < Events; ++i) {
+		signal(pool.acquire([i](Frame& frame) {
+			fillFrame(frame, static_cast<char>(i % 100));
+		}));
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	// Then.
+	long expected = 0;
+	for (int i = 0; i < Events; ++i) {
+		expected += i % 100;
+	}
+	for (auto sum : sums) {
+		EXPECT_EQ(expected, sum);
+	}
+	EXPECT_GE(pool.available(), 8);
+}
+
+TEST_F(PayloadTest, poolDestroyed_thenOutstandingPayloadStaysValid) {
+	// Given.
+	mw::Payload<Frame> payload;
+	{
+		mw::PayloadPool<Frame> pool;
+		payload = pool.acquire([](Frame& frame) {
+			fillFrame(frame, 'a');
+		});
+	}
+
+	// When.
+	auto copy = payload;
+	payload = {};
+
+	// Then.
+	EXPECT_FALSE(payload);
+	EXPECT_EQ('a', copy->data.back());
+	EXPECT_EQ(1, copy.useCount());
+}
@@ -0,0 +1,165 @@
+#include <mw/property.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+class PropertyTest : public ::testing::Test {
+protected:
+
+	PropertyTest() {
+	}
+
+	~PropertyTest() override {
+	}
+
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+TEST_F(PropertyTest, valueSet_whenChanged_thenSlotsInvokedWithNewValue) {
+	// Given.
+	mw::Property<int> points{0};
+	std::vector<int> values;
+	auto connection = points.connect([&](const int& value) {
+		values.push_back(value);
+	});
+
+	// When.
+	EXPECT_TRUE(points.set(1));
+	points = 2;
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{1, 2}), values);
+	EXPECT_EQ(2, points.get());
+	EXPECT_EQ(2, *points);
+}
+
+TEST_F(PropertyTest, sameValueSet_thenSlotsAreNotInvoked) {
+	// Given.
+	mw::Property<std::string> name{"zombie"};
+	int invoked = 0;
+	auto connection = name.connect([&](const std::string&) {
+		++invoked;
+	});
+
+	// When.
+	EXPECT_FALSE(name.set("zombie"));
+	name = std::string{"zombie"};
+
+	// Then.
+	EXPECT_EQ(0, invoked);
+	EXPECT_EQ(6, name->size());
+}
+
+TEST_F(PropertyTest, customComparison_thenSmallChangesAreIgnored) {
+	// Given.
+	auto nearlyEqual = [](double a, double b) {
+		return std::abs(a - b) < 0.1;
+	};
+	mw::Property<double, decltype(nearlyEqual)> position{0.0, mw::PropertyMode::Immediate, nearlyEqual};
+	int invoked = 0;
+	auto connection = position.connect([&](const double&) {
+		++invoked;
+	});
+
+	// When.
+	position = 0.05;
+	position = 0.5;
+
+	// Then.
+	EXPECT_EQ(1, invoked);
+	EXPECT_EQ(0.5, position.get());
+}
+
+TEST_F(PropertyTest, deferredMode_thenSlotsInvokedOncePerFlush) {
+	// Given.
+	mw::Property<int> points{0, mw::PropertyMode::Deferred};
+	std::vector<int> values;
+	auto connection = points.connect([&](const int& value) {
+		values.push_back(value);
+	});
+
+	// When.
+	points = 1;
+	points = 2;
+	points = 3;
+
+	// Then.
+	EXPECT_TRUE(values.empty());
+	EXPECT_TRUE(points.dirty());
+
+	// When.
+	points.flush();
+	points.flush();
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{3}), values);
+	EXPECT_FALSE(points.dirty());
+}
+
+TEST_F(PropertyTest, deferredMode_whenChangedBackBeforeFlush_thenSlotsAreNotInvoked) {
+	// Given.
+	mw::Property<std::string> name{"A", mw::PropertyMode::Deferred};
+	std::vector<std::string> values;
+	auto connection = name.connect([&](const std::string& value) {
+		values.push_back(value);
+	});
+
+	// When.
+	name = "B";
+	name = "A";
+
+	// Then.
+	EXPECT_FALSE(name.dirty());
+
+	// When.
+	name.flush();
+	name = "B";
+	name = "C";
+	name.flush();
+
+	// Then.
+	EXPECT_EQ((std::vector<std::string>{"C"}), values);
+	EXPECT_EQ("C", name.get());
+}
+
+namespace {
+
+	class Zombie {
+	public:
+		mw::PublicProperty<Zombie, int> points;
+
+		void walk() {
+			points = points + 1;
+		}
+
+		void stand() {
+			points = points.get();
+		}
+	};
+
+}
+
+TEST_F(PropertyTest, publicProperty_thenOnlyFriendCanChangeValue) {
+	// Given.
+	Zombie zombie;
+	std::vector<int> values;
+	auto connection = zombie.points.connect([&](const int& points) {
+		values.push_back(points);
+	});
+
+	// When.
+	zombie.walk();
+	zombie.stand();
+	zombie.walk();
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{1, 2}), values);
+	EXPECT_EQ(2, zombie.points.get());
+}
@@ -0,0 +1,162 @@
+#include <mw/realtimesignal.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+class RealtimeSignalTest : public ::testing::Test {
+protected:
+
+	RealtimeSignalTest() {
+	}
+
+	~RealtimeSignalTest() override {
+	}
+
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+namespace {
+
+	struct DestructionCounter {
+		explicit DestructionCounter(std::atomic<int>& destroyed)
+			: destroyed_{&destroyed} {
+		}
+
+		DestructionCounter(const DestructionCounter& counter) = default;
+
+		~DestructionCounter() {
+			if (destroyed_ != nullptr) {
+				destroyed_->fetch_add(1);
+			}
+		}
+
+		std::atomic<int>* destroyed_;
+	};
+
+}
+
+TEST_F(RealtimeSignalTest, connected_whenInvoked_thenSlotsCalledInOrder) {
+	// Given.
+	mw::RealtimeSignal<int> signal;
+	std::vector<int> values;
+	auto c1 = signal.connect([&](int value) { values.push_back(value); });
+	auto c2 = signal.connect([&](int value) { values.push_back(value * 10); });
+
+	// When.
+	signal(1);
+	c1.disconnect();
+	signal(2);
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{1, 10, 20}), values);
+	EXPECT_EQ(1, signal.size());
+	EXPECT_FALSE(c1.connected());
+}
+
+TEST_F(RealtimeSignalTest, clear_thenAllConnectionsDisconnected) {
+	// Given.
+	mw::RealtimeSignal<> signal;
+	auto c1 = signal.connect([]() { FAIL(); });
+	auto c2 = signal.connect([]() { FAIL(); });
+
+	// When.
+	signal.clear();
+	signal();
+
+	// Then.
+	EXPECT_TRUE(signal.empty());
+	EXPECT_FALSE(c1.connected());
+	EXPECT_FALSE(c2.connected());
+}
+
+TEST_F(RealtimeSignalTest, disconnectedCallback_thenDestroyedOnControlThread) {
+	// Given.
+	std::atomic<int> destroyed = 0;
+	mw::RealtimeSignal<> signal;
+	auto connection = signal.connect([counter = DestructionCounter{destroyed}]() {});
+	const auto destroyedAfterConnect = destroyed.load();
+
+	// When.
+	connection.disconnect();
+	signal.collect();
+
+	// Then.
+	EXPECT_EQ(destroyedAfterConnect + 1, destroyed.load());
+}
+
+TEST_F(RealtimeSignalTest, nestedInvoke_thenBothInvokesCallSlots) {
+	// Given.
+	mw::RealtimeSignal<int> signal;
+	int calls = 0;
+	auto connection = signal.connect([&](int depth) {
+		++calls;
+		if (depth > 0) {
+			signal(depth - 1);
+		}
+	});
+
+	// When.
+	signal(3);
+
+	// Then.
+	EXPECT_EQ(4, calls);
+}
+
+TEST_F(RealtimeSignalTest, slotThrows_thenLaterInvokesUseNewListAndRetiredSlotIsDestroyed) {
+	// Given.
+	std::atomic<int> destroyed = 0;
+	mw::RealtimeSignal<> signal;
+	auto c1 = signal.connect([counter = DestructionCounter{destroyed}]() {
+		throw std::runtime_error{"slot"};
+	});
+	const auto destroyedAfterConnect = destroyed.load();
+	EXPECT_THROW(signal(), std::runtime_error);
+
+	// When.
+	c1.disconnect();
+	signal.collect();
+	int calls = 0;
+	auto c2 = signal.connect([&calls]() {
+		++calls;
+	});
+	signal();
+
+	// Then.
+	EXPECT_EQ(destroyedAfterConnect + 1, destroyed.load());
+	EXPECT_EQ(1, calls);
+}
+
+TEST_F(RealtimeSignalTest, controlThreadConnectsWhileRealtimeThreadInvokes_thenNoSlotIsLost) {
+	// Given.
+	mw::RealtimeSignal<int> signal;
+	std::atomic<long long> sum = 0;
+	auto permanent = signal.connect([&](int value) { sum.fetch_add(value, std::memory_order_relaxed); });
+	std::atomic<bool> running = true;
+	long long invokes = 0;
+
+	// When.
+	std::thread realtime{[&]() {
+		while (running.load()) {
+			signal(1);
+			++invokes;
+		}
+	}};
+	for (int i = 0; i < 2000; ++i) {
+		auto connection = signal.connect([](int) {});
+		connection.disconnect();
+	}
+	running = false;
+	realtime.join();
+
+	// Then.
+	EXPECT_EQ(invokes, sum.load());
+	EXPECT_EQ(1, signal.size());
+}
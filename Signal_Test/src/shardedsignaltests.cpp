@@ -0,0 +1,216 @@
+#include <mw/shardedsignal.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class ShardedSignalTest : public ::testing::Test {
+protected:
+
+	ShardedSignalTest() {
+	}
+
+	~ShardedSignalTest() override {
+	}
+
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+TEST_F(ShardedSignalTest, connectedFromManyThreads_whenInvoked_thenAllSlotsCalled) {
+	// Given.
+	const int Threads = 8;
+	const int SlotsPerThread = 100;
+	mw::ShardedSignal<int> signal{4};
+	std::atomic<int> sum{0};
+	std::vector<std::vector<mw::signals::Connection>> connections(Threads);
+	std::vector<std::thread> threads;
+	for (int i = 0; i < Threads; ++i) {
+		threads.emplace_back([&, i]() {
+			for (int j = 0; j < SlotsPerThread; ++j) {
+				connections[i].push_back(signal.connect([&sum](int value) {
+					sum += value;
+				}));
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	// When.
+	signal(2);
+
+	// Then.
+	EXPECT_EQ(4, signal.shards());
+	EXPECT_EQ(Threads * SlotsPerThread, signal.size());
+	EXPECT_EQ(2 * Threads * SlotsPerThread, sum);
+}
+
+TEST_F(ShardedSignalTest, disconnectedFromOtherThread_thenSlotIsNotCalled) {
+	// Given.
+	mw::ShardedSignal<> signal{2};
+	int invoked = 0;
+	auto c1 = signal.connect([&invoked]() {
+		++invoked;
+	});
+	auto c2 = signal.connect([]() {
+		FAIL();
+	});
+
+	// When.
+	std::thread{[&c2]() {
+		c2.disconnect();
+	}}.join();
+	signal();
+
+	// Then.
+	EXPECT_EQ(1, invoked);
+	EXPECT_EQ(1, signal.size());
+	EXPECT_TRUE(c1.connected());
+	EXPECT_FALSE(c2.connected());
+}
+
+TEST_F(ShardedSignalTest, sameConnectionDisconnectedFromTwoThreads_thenSlotIsRemovedOnce) {
+	// Given.
+	const int Iterations = 1000;
+	mw::ShardedSignal<> signal{2};
+	auto permanent = signal.connect([]() {});
+
+	for (int i = 0; i < Iterations; ++i) {
+		auto connection = signal.connect([]() {});
+		auto copy = connection;
+		std::atomic<bool> start{false};
+
+		// When.
+		std::thread other{[&]() {
+			while (!start.load(std::memory_order_acquire)) {
+			}
+			copy.disconnect();
+		}};
+		start.store(true, std::memory_order_release);
+		connection.disconnect();
+		other.join();
+
+		// Then.
+		ASSERT_FALSE(connection.connected());
+		ASSERT_FALSE(copy.connected());
+		ASSERT_EQ(1, signal.size());
+	}
+	EXPECT_TRUE(permanent.connected());
+}
+
+TEST_F(ShardedSignalTest, disconnectingDuringInvoke_thenDisconnectedCallbackIsNotInvoked) {
+	// Given.
+	mw::ShardedSignal<> signal{1};
+	mw::signals::Connection c1;
+	mw::signals::Connection c2;
+	int invoked = 0;
+	auto disconnectBoth = [&]() {
+		++invoked;
+		c1.disconnect();
+		c2.disconnect();
+	};
+	c1 = signal.connect(disconnectBoth);
+	c2 = signal.connect(disconnectBoth);
+
+	// When.
+	signal.invoke();
+
+	// Then.
+	EXPECT_EQ(1, invoked);
+	EXPECT_TRUE(signal.empty());
+}
+
+TEST_F(ShardedSignalTest, connectingAndInvokingDuringInvoke_thenNewCallbackIsOnlyCalledByNestedInvoke) {
+	// Given.
+	mw::ShardedSignal<int> signal;
+	std::vector<int> values;
+	mw::signals::ScopedConnections connections;
+	connections += signal.connect([&](int value) {
+		values.push_back(value);
+		if (value == 1) {
+			connections += signal.connect([&](int value) {
+				values.push_back(10 * value);
+			});
+			signal(2);
+		}
+	});
+
+	// When.
+	signal(1);
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{1, 2, 20}), values);
+	EXPECT_EQ(2, signal.size());
+}
+
+TEST_F(ShardedSignalTest, concurrentConnectDisconnectAndInvoke_thenSignalIsConsistent) {
+	// Given.
+	const int Threads = 4;
+	const int Iterations = 2000;
+	mw::ShardedSignal<int> signal;
+	std::atomic<int> calls{0};
+	auto permanent = signal.connect([&calls](int) {
+		++calls;
+	});
+
+	// When.
+	std::vector<std::thread> threads;
+	for (int i = 0; i < Threads; ++i) {
+		threads.emplace_back([&]() {
+			for (int j = 0; j < Iterations; ++j) {
+				auto connection = signal.connect([](int) {});
+				signal(j);
+				connection.disconnect();
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+
+	// Then.
+	EXPECT_EQ(Threads * Iterations, calls);
+	EXPECT_EQ(1, signal.size());
+}
+
+TEST_F(ShardedSignalTest, signalDestroyed_thenConnectionsAreDisconnected) {
+	// Given.
+	mw::signals::Connection connection;
+	{
+		mw::ShardedSignal<int> signal;
+		connection = signal.connect([](int) {});
+		EXPECT_TRUE(connection.connected());
+	}
+
+	// When.
+	connection.disconnect();
+
+	// Then.
+	EXPECT_FALSE(connection.connected());
+}
+
+TEST_F(ShardedSignalTest, connectMemberFunction_whenInvoked_thenMemberFunctionIsCalled) {
+	// Given.
+	struct Listener {
+		void onValue(int value) {
+			sum += value;
+		}
+		int sum = 0;
+	} listener;
+	mw::ShardedSignal<int> signal;
+	mw::signals::ScopedConnection connection = signal.connect(&listener, &Listener::onValue);
+
+	// When.
+	signal(3);
+	signal(4);
+
+	// Then.
+	EXPECT_EQ(7, listener.sum);
+}
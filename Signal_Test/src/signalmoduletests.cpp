@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+import mw.signal;
+
+class SignalModuleTest : public ::testing::Test {
+protected:
+
+	SignalModuleTest() {
+	}
+
+	~SignalModuleTest() override {
+	}
+
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+namespace {
+
+	struct Owner {
+		mw::PublicSignal<Owner, int> signal;
+
+		void emit(int value) {
+			signal(value);
+		}
+	};
+
+}
+
+TEST_F(SignalModuleTest, importedSignal_whenInvoked_thenSlotIsCalled) {
+	// Given.
+	mw::Signal<int> signal;
+	int value = 0;
+	mw::signals::ScopedConnection connection = signal.connect([&value](int x) {
+		value = x;
+	});
+
+	// When.
+	signal(3);
+
+	// Then.
+	EXPECT_EQ(3, value);
+}
+
+TEST_F(SignalModuleTest, importedPublicSignal_whenEmitted_thenSlotsAreCalled) {
+	// Given.
+	Owner owner;
+	int sum = 0;
+	mw::signals::ScopedConnections connections;
+	connections += owner.signal.connect([&sum](int x) {
+		sum += x;
+	});
+	connections += owner.signal.connect([&sum](int x) {
+		sum += 10 * x;
+	});
+
+	// When.
+	owner.emit(2);
+
+	// Then.
+	EXPECT_EQ(22, sum);
+}
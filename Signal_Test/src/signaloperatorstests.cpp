@@ -0,0 +1,163 @@
+#include <mw/signaloperators.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+class SignalOperatorsTest : public ::testing::Test {
+protected:
+
+	SignalOperatorsTest() {
+	}
+
+	~SignalOperatorsTest() override {
+	}
+
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+using namespace mw::signals;
+
+TEST_F(SignalOperatorsTest, filterAndMap_whenInvoked_thenOnlyMappedMatchingValuesArrive) {
+	// Given.
+	mw::Signal<int> signal;
+	std::vector<std::string> values;
+	auto connection = (signal
+		| filter([](int value) { return value % 2 == 0; })
+		| map([](int value) { return std::to_string(value * 10); }))
+		.connect([&](const std::string& value) {
+			values.push_back(value);
+		});
+
+	// When.
+	for (int i = 1; i <= 5; ++i) {
+		signal(i);
+	}
+
+	// Then.
+	EXPECT_EQ((std::vector<std::string>{"20", "40"}), values);
+	EXPECT_EQ(1, signal.size());
+}
+
+TEST_F(SignalOperatorsTest, distinctUntilChanged_thenRepeatedValuesAreSkipped) {
+	// Given.
+	mw::Signal<int, char> signal;
+	std::vector<char> values;
+	auto connection = (signal | distinctUntilChanged()).connect([&](int, char c) {
+		values.push_back(c);
+	});
+
+	// When.
+	signal(1, 'a');
+	signal(1, 'a');
+	signal(1, 'b');
+	signal(2, 'b');
+	signal(2, 'b');
+
+	// Then.
+	EXPECT_EQ((std::vector<char>{'a', 'b', 'b'}), values);
+}
+
+TEST_F(SignalOperatorsTest, takeAndScan_thenAccumulatedValuesOfFirstInvokesArrive) {
+	// Given.
+	mw::Signal<int> signal;
+	std::vector<int> values;
+	auto connection = (signal
+		| take(3)
+		| scan(0, [](int sum, int value) { return sum + value; }))
+		.connect([&](int sum) {
+			values.push_back(sum);
+		});
+
+	// When.
+	for (int i = 1; i <= 5; ++i) {
+		signal(i);
+	}
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{1, 3, 6}), values);
+}
+
+TEST_F(SignalOperatorsTest, samePipelineConnectedTwice_thenStateIsPerConnection) {
+	// Given.
+	mw::Signal<int> signal;
+	auto pipeline = signal | take(1);
+	int first = 0;
+	int second = 0;
+	auto c1 = pipeline.connect([&](int) { ++first; });
+	signal(1);
+
+	// When.
+	auto c2 = pipeline.connect([&](int) { ++second; });
+	signal(2);
+
+	// Then.
+	EXPECT_EQ(1, first);
+	EXPECT_EQ(1, second);
+}
+
+TEST_F(SignalOperatorsTest, fiveStagePipeline_thenSingleSlotIsConnected) {
+	// Given.
+	mw::Signal<int> signal;
+	int result = 0;
+	auto connection = (signal
+		| filter([](int value) { return value > 0; })
+		| map([](int value) { return value * 2; })
+		| distinctUntilChanged()
+		| scan(0, [](int sum, int value) { return sum + value; })
+		| take(10))
+		.connect([&](int sum) {
+			result = sum;
+		});
+
+	// When.
+	signal(1);
+	signal(1);
+	signal(-1);
+	signal(2);
+
+	// Then.
+	EXPECT_EQ(1, signal.size());
+	EXPECT_EQ(2 + 4, result);
+
+	// When.
+	connection.disconnect();
+
+	// Then.
+	EXPECT_TRUE(signal.empty());
+}
+
+namespace {
+
+	class Player {
+	public:
+		mw::PublicSignal<Player, int> healthChanged;
+
+		void setHealth(int health) {
+			healthChanged(health);
+		}
+	};
+
+}
+
+TEST_F(SignalOperatorsTest, publicSignalPipeline_thenConnectedToPublicSignal) {
+	// Given.
+	Player player;
+	std::vector<int> values;
+	auto connection = (player.healthChanged | filter([](int health) { return health <= 0; }))
+		.connect([&](int health) {
+			values.push_back(health);
+		});
+
+	// When.
+	player.setHealth(10);
+	player.setHealth(0);
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{0}), values);
+}
@@ -0,0 +1,175 @@
+#include <mw/signalrecorder.h>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <iterator>
+#include <system_error>
+#include <vector>
+
+class SignalRecorderTest : public ::testing::Test {
+protected:
+
+	SignalRecorderTest() {
+	}
+
+	~SignalRecorderTest() override {
+	}
+
+	void SetUp() override {
+		const auto name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+		path_ = std::filesystem::temp_directory_path() / (std::string{"signalrecordertest_"} + name + ".bin");
+	}
+
+	void TearDown() override {
+		std::error_code ec;
+		std::filesystem::remove(path_, ec);
+	}
+
+	std::filesystem::path path_;
+};
+
+struct Position {
+	float x;
+	float y;
+};
+
+TEST_F(SignalRecorderTest, recordedEmissions_whenReplayed_thenSignalIsInvokedWithSameArguments) {
+	// Given.
+	mw::Signal<int, Position> signal;
+	{
+		mw::SignalRecorder recorder{path_};
+		recorder.record(signal, 1);
+
+		signal(1, Position{1.f, 2.f});
+		signal(2, Position{3.f, 4.f});
+		EXPECT_EQ(2, recorder.records());
+	}
+
+	// When.
+	std::vector<std::pair<int, float>> values;
+	mw::Signal<int, Position> replayed;
+	auto connection = replayed.connect([&](int value, Position position) {
+		values.emplace_back(value, position.y);
+	});
+	mw::SignalReplayer replayer{path_};
+	replayer.bind(1, replayed);
+
+	// Then.
+	EXPECT_EQ(2, replayer.records());
+	EXPECT_EQ(2, replayer.replay());
+	ASSERT_EQ(2, values.size());
+	EXPECT_EQ(std::make_pair(1, 2.f), values[0]);
+	EXPECT_EQ(std::make_pair(2, 4.f), values[1]);
+}
+
+TEST_F(SignalRecorderTest, recordingMultipleSignals_whenReplayed_thenOrderIsPreservedPerId) {
+	// Given.
+	mw::Signal<int> a;
+	mw::Signal<double> b;
+	mw::Signal<> c;
+	{
+		mw::SignalRecorder recorder{path_};
+		recorder.record(a, 1);
+		recorder.record(b, 2);
+		recorder.record(c, 3);
+
+		a(1);
+		b(2.0);
+		c();
+		a(3);
+	}
+
+	// When.
+	std::vector<double> values;
+	mw::SignalReplayer replayer{path_};
+	replayer.bind<int>(1, [&](int value) {
+		values.push_back(value);
+	});
+	replayer.bind<double>(2, [&](double value) {
+		values.push_back(value);
+	});
+	replayer.replay();
+
+	// Then.
+	EXPECT_EQ(4, replayer.records());
+	EXPECT_EQ((std::vector<double>{1.0, 2.0, 3.0}), values);
+}
+
+TEST_F(SignalRecorderTest, smallCapacity_whenRecordingMany_thenFileGrows) {
+	// Given.
+	mw::Signal<std::uint64_t> signal;
+	const int Records = 10'000;
+	{
+		mw::SignalRecorder recorder{path_, 64};
+		recorder.record(signal, 7);
+
+		// When.
+		for (int i = 0; i < Records; ++i) {
+			signal(i);
+		}
+	}
+
+	// Then.
+	std::uint64_t sum = 0;
+	mw::SignalReplayer replayer{path_};
+	replayer.bind<std::uint64_t>(7, [&](std::uint64_t value) {
+		sum += value;
+	});
+	EXPECT_EQ(Records, replayer.replay());
+	EXPECT_EQ(std::uint64_t{Records} * (Records - 1) / 2, sum);
+}
+
+TEST_F(SignalRecorderTest, pausedOrDisconnectedRecorder_thenEmissionsAreNotRecorded) {
+	// Given.
+	mw::Signal<int> signal;
+	mw::SignalRecorder recorder{path_};
+	auto connection = recorder.record(signal, 1);
+
+	// When.
+	signal(1);
+	recorder.setPaused(true);
+	signal(2);
+	recorder.setPaused(false);
+	signal(3);
+	connection.disconnect();
+	signal(4);
+
+	// Then.
+	EXPECT_EQ(2, recorder.records());
+	EXPECT_TRUE(signal.empty());
+}
+
+TEST_F(SignalRecorderTest, recorderDestroyed_thenSignalIsDisconnected) {
+	// Given.
+	mw::Signal<int> signal;
+
+	// When.
+	{
+		mw::SignalRecorder recorder{path_};
+		recorder.record(signal, 1);
+		EXPECT_EQ(1, signal.size());
+	}
+
+	// Then.
+	EXPECT_TRUE(signal.empty());
+}
+
+#ifdef __linux__
+
+TEST_F(SignalRecorderTest, fileCannotBeResized_thenConstructorThrowsAndFileIsClosed) {
+	// Given.
+	auto openFiles = []() {
+		auto fds = std::filesystem::directory_iterator{"/proc/self/fd"};
+		return std::distance(std::filesystem::begin(fds), std::filesystem::end(fds));
+	};
+	const auto before = openFiles();
+
+	// When.
+	EXPECT_THROW(mw::signals::MappedFile(path_, mw::signals::MappedFile::Mode::Write, std::size_t{1} << 62), std::system_error);
+
+	// Then.
+	EXPECT_EQ(before, openFiles());
+}
+
+#endif
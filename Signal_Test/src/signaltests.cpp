@@ -2,6 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 class SignalTest : public ::testing::Test {
 protected:
 
@@ -546,3 +552,718 @@ TEST_F(SignalTest, testCompilable) {
 		signal(constTmp);
 	}
 }
+
+TEST_F(SignalTest, invokeBatch_thenEachSlotGetsAllEventsBeforeNextSlot) {
+	// Given.
+	mw::Signal<int, char> signal;
+	std::vector<std::string> calls;
+	[[maybe_unused]] auto c1 = signal.connect([&](int value, char c) {
+		calls.push_back("a" + std::to_string(value) + c);
+	});
+	[[maybe_unused]] auto c2 = signal.connect([&](int value, char c) {
+		calls.push_back("b" + std::to_string(value) + c);
+	});
+	const std::vector<std::tuple<int, char>> events{{1, 'x'}, {2, 'y'}};
+
+	// When.
+	signal.invokeBatch(events);
+
+	// Then.
+	EXPECT_EQ((std::vector<std::string>{"a1x", "a2y", "b1x", "b2y"}), calls);
+}
+
+TEST_F(SignalTest, batchSlot_whenInvokeBatch_thenWholeSpanIsReceivedOnce) {
+	// Given.
+	mw::Signal<int> signal;
+	int calls = 0;
+	int sum = 0;
+	[[maybe_unused]] auto c = signal.connectBatch([&](std::span<const std::tuple<int>> events) {
+		++calls;
+		for (const auto& [value] : events) {
+			sum += value;
+		}
+	});
+	const std::array<std::tuple<int>, 4> events{{{1}, {2}, {3}, {4}}};
+
+	// When.
+	signal.invokeBatch(events);
+
+	// Then.
+	EXPECT_EQ(1, calls);
+	EXPECT_EQ(10, sum);
+}
+
+TEST_F(SignalTest, batchSlot_whenInvoke_thenReceivesBatchOfOne) {
+	// Given.
+	mw::Signal<int> signal;
+	std::vector<std::size_t> sizes;
+	int value = 0;
+	auto connection = signal.connectBatch([&](std::span<const std::tuple<int>> events) {
+		sizes.push_back(events.size());
+		value = std::get<0>(events.front());
+	});
+
+	// When.
+	signal(7);
+	connection.disconnect();
+	signal(8);
+
+	// Then.
+	EXPECT_EQ((std::vector<std::size_t>{1}), sizes);
+	EXPECT_EQ(7, value);
+	EXPECT_TRUE(signal.empty());
+}
+
+TEST_F(SignalTest, referenceArguments_whenInvokeBatch_thenSlotsModifyReferencedValues) {
+	// Given.
+	mw::Signal<int&, const std::string&> signal;
+	int batches = 0;
+	[[maybe_unused]] auto c1 = signal.connect([](int& value, const std::string& text) {
+		value += static_cast<int>(text.size());
+	});
+	[[maybe_unused]] auto c2 = signal.connectBatch([&](std::span<const std::tuple<int&, const std::string&>> events) {
+		++batches;
+		for (const auto& [value, text] : events) {
+			value *= 10;
+		}
+	});
+	int first = 1;
+	int second = 2;
+	const std::string text = "abc";
+	const std::vector<std::tuple<int&, const std::string&>> events{{first, text}, {second, text}};
+
+	// When.
+	signal.invokeBatch(events);
+
+	// Then.
+	EXPECT_EQ(1, batches);
+	EXPECT_EQ(40, first);
+	EXPECT_EQ(50, second);
+}
+
+TEST_F(SignalTest, connectingManyDuringInvoke_thenExecutingCallbackIsNotMoved) {
+	// Given.
+	mw::Signal signal;
+	std::vector<mw::signals::Connection> connections;
+	int value = 7;
+	[[maybe_unused]] auto c = signal.connect([&, value]() {
+		for (int i = 0; i < 1000; ++i) {
+			connections.push_back(signal.connect([]() {}));
+		}
+		// Captured state is still valid after the storage has grown.
+		EXPECT_EQ(7, value);
+	});
+
+	// When.
+	signal.invoke();
+
+	// Then.
+	EXPECT_EQ(1001, signal.size());
+}
+
+TEST_F(SignalTest, disconnectingItselfDuringInvoke_thenRemovedAfterInvoke) {
+	// Given.
+	mw::Signal signal;
+	int invoked = 0;
+	mw::signals::Connection c1;
+	c1 = signal.connect([&]() {
+		++invoked;
+		c1.disconnect();
+		EXPECT_EQ(1, signal.size());
+	});
+	[[maybe_unused]] auto c2 = signal.connect([&]() {
+		++invoked;
+	});
+
+	// When.
+	signal.invoke();
+	signal.invoke();
+
+	// Then.
+	EXPECT_EQ(3, invoked);
+	EXPECT_EQ(1, signal.size());
+}
+
+TEST_F(SignalTest, clearDuringInvoke_thenRemainingCallbacksAreNotInvoked) {
+	// Given.
+	mw::Signal signal;
+	[[maybe_unused]] auto c1 = signal.connect([&]() {
+		signal.clear();
+	});
+	[[maybe_unused]] auto c2 = signal.connect([]() {
+		FAIL();
+	});
+
+	// When.
+	signal.invoke();
+
+	// Then.
+	EXPECT_TRUE(signal.empty());
+	EXPECT_FALSE(c2.connected());
+}
+
+TEST_F(SignalTest, movedFromDuringInvoke_thenInvokeEndsAndSlotsFollowTheSignal) {
+	// Given.
+	mw::Signal<int> signal;
+	std::unique_ptr<mw::Signal<int>> moved;
+	int calls = 0;
+	auto c1 = signal.connect([&](int) {
+		++calls;
+		moved = std::make_unique<mw::Signal<int>>(std::move(signal));
+	});
+	auto c2 = signal.connect([&calls](int) {
+		calls += 10;
+	});
+
+	// When.
+	signal(1);
+
+	// Then.
+	EXPECT_EQ(1, calls);
+	EXPECT_TRUE(signal.empty());
+	ASSERT_NE(nullptr, moved);
+	EXPECT_EQ(2, moved->size());
+
+	// When.
+	c1.disconnect();
+	(*moved)(1);
+
+	// Then.
+	EXPECT_EQ(11, calls);
+	EXPECT_TRUE(c2.connected());
+}
+
+TEST_F(SignalTest, moveAssignedDuringInvoke_thenReplacedSlotsAreDestroyedAfterInvoke) {
+	// Given.
+	mw::Signal<int> signal;
+	mw::Signal<int> other;
+	auto alive = std::make_shared<int>(1);
+	std::weak_ptr<int> watched = alive;
+	int replacedCalls = 0;
+	int newCalls = 0;
+	auto c1 = signal.connect([&, alive = std::move(alive)](int) {
+		signal = std::move(other);
+		EXPECT_EQ(1, *alive); // Still executing.
+	});
+	auto c2 = signal.connect([&replacedCalls](int) {
+		++replacedCalls;
+	});
+	auto c3 = other.connect([&newCalls](int) {
+		++newCalls;
+	});
+
+	// When.
+	signal(1);
+	signal.invokeBatch(std::array<mw::Signal<int>::Event, 2>{{{2}, {3}}});
+
+	// Then.
+	EXPECT_TRUE(watched.expired());
+	EXPECT_EQ(0, replacedCalls);
+	EXPECT_EQ(2, newCalls);
+	EXPECT_FALSE(c1.connected());
+	EXPECT_FALSE(c2.connected());
+	EXPECT_TRUE(c3.connected());
+	EXPECT_EQ(1, signal.size());
+}
+
+TEST_F(SignalTest, moveAssignedDuringInvokeBatch_thenRemainingEventsAndSlotsAreSkipped) {
+	// Given.
+	mw::Signal<int> signal;
+	int calls = 0;
+	auto c1 = signal.connect([&](int) {
+		++calls;
+		signal = mw::Signal<int>{};
+	});
+	auto c2 = signal.connect([&calls](int) {
+		calls += 10;
+	});
+
+	// When.
+	signal.invokeBatch(std::array<mw::Signal<int>::Event, 2>{{{1}, {2}}});
+
+	// Then.
+	EXPECT_EQ(1, calls);
+	EXPECT_TRUE(signal.empty());
+	EXPECT_FALSE(c2.connected());
+}
+
+TEST_F(SignalTest, forwardChain_whenInvoked_thenAllSignalsInChainAreInvokedInOrder) {
+	// Given.
+	mw::Signal<int> a, b, c, d;
+	std::string calls;
+	[[maybe_unused]] auto ca = a.connect([&](int value) { calls += "a" + std::to_string(value); });
+	[[maybe_unused]] auto cc = c.connect([&](int value) { calls += "c" + std::to_string(value); });
+	[[maybe_unused]] auto cd = d.connect([&](int value) { calls += "d" + std::to_string(value); });
+	[[maybe_unused]] auto f1 = a.forwardTo(b);
+	[[maybe_unused]] auto f2 = b.forwardTo(c);
+	[[maybe_unused]] auto f3 = c.forwardTo(d);
+
+	// When.
+	a(1);
+
+	// Then.
+	EXPECT_EQ("a1c1d1", calls);
+	EXPECT_EQ(2, a.size());
+}
+
+TEST_F(SignalTest, forwardToItself_thenThrowsAndNothingIsConnected) {
+	// Given.
+	mw::Signal<int> signal;
+
+	// When.
+	EXPECT_THROW(static_cast<void>(signal.forwardTo(signal)), std::invalid_argument);
+
+	// Then.
+	EXPECT_TRUE(signal.empty());
+}
+
+TEST_F(SignalTest, forwardBackToSource_thenThrowsAndChainStillWorks) {
+	// Given.
+	mw::Signal<int> a, b, c;
+	int calls = 0;
+	[[maybe_unused]] auto ca = a.connect([&](int) { ++calls; });
+	[[maybe_unused]] auto f1 = a.forwardTo(b);
+	[[maybe_unused]] auto f2 = b.forwardTo(c);
+
+	// When.
+	EXPECT_THROW(static_cast<void>(b.forwardTo(a)), std::invalid_argument);
+	EXPECT_THROW(static_cast<void>(c.forwardTo(a)), std::invalid_argument);
+	a(1);
+
+	// Then.
+	EXPECT_EQ(1, calls);
+	EXPECT_EQ(2, a.size());
+	EXPECT_EQ(1, b.size());
+	EXPECT_TRUE(c.empty());
+}
+
+TEST_F(SignalTest, forwardsJoiningAgain_thenNoCycleIsReported) {
+	// Given.
+	mw::Signal<int> a, b, c, d;
+	std::string calls;
+	[[maybe_unused]] auto cd = d.connect([&](int) { calls += "d"; });
+	[[maybe_unused]] auto f1 = a.forwardTo(b);
+	[[maybe_unused]] auto f2 = a.forwardTo(c);
+	[[maybe_unused]] auto f3 = b.forwardTo(d);
+
+	// When.
+	[[maybe_unused]] auto f4 = c.forwardTo(d);
+	a(1);
+
+	// Then.
+	EXPECT_EQ("dd", calls);
+}
+
+TEST_F(SignalTest, forwardToMultipleSignals_whenInvoked_thenArgumentsAreNotCopied) {
+	// Given.
+	Object::copies = 0;
+	mw::Signal<const Object&> source, target1, target2;
+	int invoked = 0;
+	[[maybe_unused]] auto c1 = target1.connect([&](const Object&) { ++invoked; });
+	[[maybe_unused]] auto c2 = target2.connect([&](const Object&) { ++invoked; });
+	[[maybe_unused]] auto f1 = source.forwardTo(target1);
+	[[maybe_unused]] auto f2 = source.forwardTo(target2);
+
+	// When.
+	Object value;
+	source(value);
+
+	// Then.
+	EXPECT_EQ(2, invoked);
+	EXPECT_EQ(0, Object::copies);
+}
+
+TEST_F(SignalTest, forwardDisconnected_thenTargetIsNotInvoked) {
+	// Given.
+	mw::Signal<> source, target;
+	[[maybe_unused]] auto c = target.connect([]() { FAIL(); });
+	auto forward = source.forwardTo(target);
+
+	// When.
+	forward.disconnect();
+	source();
+
+	// Then.
+	EXPECT_TRUE(source.empty());
+	EXPECT_FALSE(forward.connected());
+}
+
+TEST_F(SignalTest, forwardTargetDestroyed_thenForwardIsDisconnected) {
+	// Given.
+	mw::Signal<> source;
+	mw::signals::Connection forward;
+	{
+		mw::Signal<> target;
+		forward = source.forwardTo(target);
+		EXPECT_TRUE(forward.connected());
+	}
+
+	// When.
+	source();
+
+	// Then.
+	EXPECT_FALSE(forward.connected());
+	EXPECT_TRUE(source.empty());
+}
+
+TEST_F(SignalTest, forwardSourceDestroyed_thenTargetCanBeDestroyed) {
+	// Given.
+	auto target = std::make_unique<mw::Signal<>>();
+	mw::signals::Connection forward;
+	{
+		mw::Signal<> source;
+		forward = source.forwardTo(*target);
+	}
+
+	// When/Then.
+	EXPECT_FALSE(forward.connected());
+	target.reset();
+}
+
+TEST_F(SignalTest, forwardSourceAndTargetMoved_thenForwardFollows) {
+	// Given.
+	mw::Signal<int> source, target;
+	int value = 0;
+	[[maybe_unused]] auto c = target.connect([&](int x) { value = x; });
+	auto forward = source.forwardTo(target);
+
+	// When.
+	mw::Signal<int> movedTarget = std::move(target);
+	mw::Signal<int> movedSource;
+	movedSource = std::move(source);
+	source(1);
+	target(2);
+	movedSource(3);
+
+	// Then.
+	EXPECT_EQ(3, value);
+	EXPECT_TRUE(forward.connected());
+	forward.disconnect();
+	EXPECT_TRUE(movedSource.empty());
+}
+
+TEST_F(SignalTest, forwardTargetDestroyedDuringInvoke_thenForwardIsSkipped) {
+	// Given.
+	mw::Signal<> source;
+	auto target = std::make_unique<mw::Signal<>>();
+	[[maybe_unused]] auto c1 = target->connect([]() { FAIL(); });
+	[[maybe_unused]] auto c2 = source.connect([&]() { target.reset(); });
+	[[maybe_unused]] auto forward = source.forwardTo(*target);
+
+	// When.
+	source();
+
+	// Then.
+	EXPECT_EQ(1, source.size());
+}
+
+TEST_F(SignalTest, forwardInvokeBatch_thenTargetGetsBatch) {
+	// Given.
+	mw::Signal<int> source, target;
+	int sum = 0;
+	[[maybe_unused]] auto c = target.connect([&](int x) { sum += x; });
+	[[maybe_unused]] auto forward = source.forwardTo(target);
+	const std::array<std::tuple<int>, 3> events{{{1}, {2}, {3}}};
+
+	// When.
+	source.invokeBatch(events);
+
+	// Then.
+	EXPECT_EQ(6, sum);
+}
+
+TEST_F(SignalTest, forwardDisconnectedAndShrunk_thenForwardStateIsReleased) {
+	// Given.
+	mw::Signal<int> source, target;
+	auto forward = source.forwardTo(target);
+	const auto forwardingUsage = source.memoryUsage();
+
+	// When.
+	forward.disconnect();
+	source.shrink_to_fit();
+	target.shrink_to_fit();
+
+	// Then.
+	EXPECT_LT(sizeof(source), forwardingUsage);
+	EXPECT_EQ(sizeof(source), source.memoryUsage());
+	EXPECT_EQ(sizeof(target), target.memoryUsage());
+}
+
+TEST_F(SignalTest, connectionsAdded_thenMemoryUsageGrows) {
+	// Given.
+	mw::Signal signal;
+	const auto emptyUsage = signal.memoryUsage();
+
+	// When.
+	[[maybe_unused]] auto connection = signal.connect(emptyCallback);
+
+	// Then.
+	EXPECT_EQ(sizeof(mw::Signal<>), emptyUsage);
+	EXPECT_GT(signal.memoryUsage(), emptyUsage);
+}
+
+TEST_F(SignalTest, secondSlotConnected_thenOnlyItsKeyIsAllocated) {
+	// Given.
+	mw::Signal signal;
+	mw::signals::ScopedConnections connections;
+	connections += signal.connect(emptyCallback);
+	const auto oneSlotUsage = signal.memoryUsage();
+
+	// When.
+	connections += signal.connect(emptyCallback);
+	const auto twoSlotsUsage = signal.memoryUsage();
+	connections += signal.connect(emptyCallback);
+
+	// Then.
+	EXPECT_LT(twoSlotsUsage - oneSlotUsage, signal.memoryUsage() - twoSlotsUsage);
+}
+
+TEST_F(SignalTest, manySlotsConnectedAndMostDisconnected_whenShrunk_thenRemainingSlotsAreInvoked) {
+	// Given.
+	mw::Signal<int> signal;
+	std::vector<mw::signals::Connection> connections;
+	int sum = 0;
+	for (int i = 0; i < 100; ++i) {
+		connections.push_back(signal.connect([&sum](int value) {
+			sum += value;
+		}));
+	}
+	const auto usage = signal.memoryUsage();
+	for (int i = 3; i < 100; ++i) {
+		connections[i].disconnect();
+	}
+
+	// When.
+	signal.shrink_to_fit();
+	signal(1);
+	connections.push_back(signal.connect([&sum](int value) {
+		sum += 10 * value;
+	}));
+	signal(1);
+
+	// Then.
+	EXPECT_GT(usage, signal.memoryUsage());
+	EXPECT_EQ(3 + 3 + 10, sum);
+	EXPECT_EQ(4, signal.size());
+}
+
+TEST_F(SignalTest, moveOnlyCallable_whenConnected_thenMovedIntoSlot) {
+	// Given.
+	mw::Signal<int> signal;
+	int result = 0;
+	auto buffer = std::make_unique<int>(5);
+
+	// When.
+	[[maybe_unused]] auto c = signal.connect([buffer = std::move(buffer), &result](int value) {
+		result = *buffer * value;
+	});
+	signal(3);
+
+	// Then.
+	EXPECT_EQ(15, result);
+	EXPECT_FALSE(buffer);
+}
+
+namespace {
+
+	struct MoveCounter {
+		MoveCounter(int& copies, int& moves)
+			: copies_{&copies}
+			, moves_{&moves} {
+		}
+
+		MoveCounter(const MoveCounter& counter)
+			: copies_{counter.copies_}
+			, moves_{counter.moves_} {
+			++*copies_;
+		}
+
+		MoveCounter(MoveCounter&& counter) noexcept
+			: copies_{counter.copies_}
+			, moves_{counter.moves_} {
+			++*moves_;
+		}
+
+		void operator()() const {
+		}
+
+		int* copies_;
+		int* moves_;
+	};
+
+}
+
+TEST_F(SignalTest, rvalueCallable_whenConnected_thenNeverCopied) {
+	// Given.
+	mw::Signal signal;
+	int copies = 0;
+	int moves = 0;
+
+	// When.
+	[[maybe_unused]] auto c1 = signal.connect(MoveCounter{copies, moves});
+	for (int i = 0; i < 20; ++i) {
+		[[maybe_unused]] auto c = signal.connect([]() {});
+	}
+	signal();
+
+	// Then.
+	EXPECT_EQ(0, copies);
+	EXPECT_EQ(1, moves);
+}
+
+namespace {
+
+	struct Owner {
+		mw::PublicSignal<Owner, int> signal;
+
+		void emit(int value) {
+			signal(value);
+		}
+	};
+
+}
+
+TEST_F(SignalTest, largeMoveOnlyCallable_whenConnected_thenStoredOnHeapAndInvoked) {
+	// Given.
+	Owner owner;
+	std::array<int, 64> large{};
+	large[63] = 2;
+	int result = 0;
+
+	// When.
+	[[maybe_unused]] auto c = owner.signal.connect([large, owned = std::make_unique<int>(3), &result](int value) {
+		result = large[63] * *owned * value;
+	});
+	owner.emit(7);
+
+	// Then.
+	EXPECT_EQ(42, result);
+}
+
+TEST_F(SignalTest, noListeners_whenInvokeWith_thenFactoryIsNotCalled) {
+	// Given.
+	mw::Signal<const std::string&> signal;
+	auto connection = signal.connect([](const std::string&) {});
+	connection.disconnect();
+	int built = 0;
+
+	// When.
+	bool invoked = signal.invokeWith([&]() {
+		++built;
+		return std::string(100, 'x');
+	});
+
+	// Then.
+	EXPECT_FALSE(invoked);
+	EXPECT_FALSE(signal.hasListeners());
+	EXPECT_EQ(0, built);
+}
+
+TEST_F(SignalTest, forwardsToSignalsWithoutSlots_whenInvokeWith_thenFactoryIsNotCalled) {
+	// Given.
+	mw::Signal<const std::string&> signal;
+	mw::Signal<const std::string&> first;
+	mw::Signal<const std::string&> second;
+	mw::Signal<const std::string&> chained;
+	mw::signals::ScopedConnections connections;
+	connections += signal.forwardTo(first);
+	connections += signal.forwardTo(second);
+	connections += second.forwardTo(chained);
+	int built = 0;
+
+	// When.
+	bool invoked = signal.invokeWith([&]() {
+		++built;
+		return std::string(100, 'x');
+	});
+
+	// Then.
+	EXPECT_FALSE(invoked);
+	EXPECT_FALSE(signal.hasListeners());
+	EXPECT_EQ(0, built);
+}
+
+TEST_F(SignalTest, forwardChainEndingInSlot_thenHasListeners) {
+	// Given.
+	mw::Signal<int> signal;
+	mw::Signal<int> middle;
+	mw::Signal<int> last;
+	mw::signals::ScopedConnections connections;
+	connections += signal.forwardTo(middle);
+	connections += middle.forwardTo(last);
+	EXPECT_FALSE(signal.hasListeners());
+
+	// When.
+	connections += last.connect([](int) {});
+
+	// Then.
+	EXPECT_TRUE(signal.hasListeners());
+	EXPECT_TRUE(middle.hasListeners());
+}
+
+TEST_F(SignalTest, listeners_whenInvokeWith_thenPayloadIsBuiltOnceAndShared) {
+	// Given.
+	mw::Signal<const std::string&> signal;
+	mw::Signal<const std::string&> target;
+	std::vector<const std::string*> received;
+	mw::signals::ScopedConnections connections;
+	for (int i = 0; i < 3; ++i) {
+		connections += signal.connect([&](const std::string& text) {
+			received.push_back(&text);
+		});
+	}
+	connections += target.connect([&](const std::string& text) {
+		received.push_back(&text);
+	});
+	connections += signal.forwardTo(target);
+	int built = 0;
+
+	// When.
+	bool invoked = signal.invokeWith([&]() {
+		++built;
+		return std::string(100, 'x');
+	});
+
+	// Then.
+	EXPECT_TRUE(invoked);
+	EXPECT_EQ(1, built);
+	ASSERT_EQ(4, received.size());
+	for (auto text : received) {
+		EXPECT_EQ(received.front(), text);
+	}
+}
+
+TEST_F(SignalTest, multipleArguments_whenInvokeWithTupleFactory_thenArgumentsAreUnpacked) {
+	// Given.
+	mw::Signal<int, const std::string&> signal;
+	std::string result;
+	auto connection = signal.connect([&](int nbr, const std::string& text) {
+		result = text + std::to_string(nbr);
+	});
+
+	// When.
+	signal.invokeWith([]() {
+		return std::tuple{7, std::string{"value "}};
+	});
+
+	// Then.
+	EXPECT_EQ("value 7", result);
+}
+
+TEST_F(SignalTest, factoryReturningReference_whenInvokeWith_thenReferencedValueIsNotCopied) {
+	// Given.
+	mw::Signal<const std::string&> signal;
+	const std::string text(100, 'x');
+	const std::string* received = nullptr;
+	auto connection = signal.connect([&](const std::string& value) {
+		received = &value;
+	});
+
+	// When.
+	signal.invokeWith([&text]() -> const std::string& {
+		return text;
+	});
+
+	// Then.
+	EXPECT_EQ(&text, received);
+}
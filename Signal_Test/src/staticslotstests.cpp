@@ -0,0 +1,72 @@
+#include <mw/staticslots.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+class StaticSlotsTest : public ::testing::Test {
+protected:
+
+	StaticSlotsTest() {
+	}
+
+	~StaticSlotsTest() override {
+	}
+
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+};
+
+namespace {
+
+	std::string calls;
+
+	void onTickA(int dt) {
+		calls += "a" + std::to_string(dt);
+	}
+
+	void onTickB(int dt) {
+		calls += "b" + std::to_string(dt);
+	}
+
+	void onTickConst(const int& dt) {
+		calls += "c" + std::to_string(dt);
+	}
+
+	constexpr int sum(int a, int b) {
+		int total = 0;
+		mw::StaticSlots<[](int& total, int value) { total += value; },
+			[](int& total, int value) { total += value * 10; }> signal;
+		signal(total, a);
+		signal(total, b);
+		return total;
+	}
+
+}
+
+TEST_F(StaticSlotsTest, invoked_thenSlotsAreCalledInOrder) {
+	// Given.
+	calls.clear();
+	mw::StaticSlots<&onTickA, &onTickB, &onTickConst> signal;
+
+	// When.
+	signal(1);
+	signal.invoke(2);
+
+	// Then.
+	EXPECT_EQ("a1b1c1a2b2c2", calls);
+}
+
+TEST_F(StaticSlotsTest, sizeAndEmpty_areKnownAtCompileTime) {
+	static_assert(mw::StaticSlots<&onTickA, &onTickB>::size() == 2);
+	static_assert(!mw::StaticSlots<&onTickA>::empty());
+	static_assert(mw::StaticSlots<>::empty());
+	static_assert(sizeof(mw::StaticSlots<&onTickA, &onTickB>) == 1);
+}
+
+TEST_F(StaticSlotsTest, lambdaSlots_whenInvokedInConstantExpression_thenEvaluatedAtCompileTime) {
+	static_assert(sum(1, 2) == 33);
+}
@@ -0,0 +1,236 @@
+#include <mw/timedsignal.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+class TimedSignalTest : public ::testing::Test {
+protected:
+
+	TimedSignalTest() {
+	}
+
+	~TimedSignalTest() override {
+	}
+
+	void SetUp() override {
+	}
+
+	void TearDown() override {
+	}
+
+	mw::signals::TimerWheel wheel{1ms};
+};
+
+TEST_F(TimedSignalTest, timersScheduled_whenAdvanced_thenFiredInExpiryOrder) {
+	// Given.
+	std::vector<int> fired;
+	wheel.schedule(30ms, [&]() { fired.push_back(30); });
+	wheel.schedule(10ms, [&]() { fired.push_back(10); });
+	wheel.schedule(20ms, [&]() { fired.push_back(20); });
+
+	// When.
+	wheel.advance(15ms);
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{10}), fired);
+	EXPECT_EQ(2, wheel.size());
+
+	// When.
+	wheel.advance(15ms);
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{10, 20, 30}), fired);
+	EXPECT_EQ(0, wheel.size());
+}
+
+TEST_F(TimedSignalTest, timerCanceled_thenNotFired) {
+	// Given.
+	bool fired = false;
+	auto id = wheel.schedule(5ms, [&]() { fired = true; });
+	EXPECT_TRUE(wheel.pending(id));
+
+	// When.
+	EXPECT_TRUE(wheel.cancel(id));
+	wheel.advance(10ms);
+
+	// Then.
+	EXPECT_FALSE(fired);
+	EXPECT_FALSE(wheel.pending(id));
+	EXPECT_FALSE(wheel.cancel(id));
+}
+
+TEST_F(TimedSignalTest, manyTimersOnAllLevels_thenEachFiresAtItsTick) {
+	// Given.
+	std::mt19937 random{1};
+	std::uniform_int_distribution<int> delays{1, 300'000};
+	int errors = 0;
+	for (int i = 0; i < 20'000; ++i) {
+		const auto delay = delays(random);
+		wheel.schedule(std::chrono::milliseconds{delay}, [&, expires = wheel.now() + delay]() {
+			if (wheel.now() != expires) {
+				++errors;
+			}
+		});
+	}
+
+	// When.
+	for (int i = 0; i < 300; ++i) {
+		wheel.advance(1s);
+	}
+
+	// Then.
+	EXPECT_EQ(0, errors);
+	EXPECT_EQ(0, wheel.size());
+}
+
+TEST_F(TimedSignalTest, emitAfter_thenSlotsInvokedAfterDelay) {
+	// Given.
+	mw::TimedSignal<int> signal{wheel};
+	std::vector<int> values;
+	auto connection = signal.connect([&](int value) {
+		values.push_back(value);
+	});
+
+	// When.
+	signal.emitAfter(10ms, 1);
+	auto canceled = signal.emitAfter(10ms, 2);
+	signal.cancel(canceled);
+	signal(3);
+	wheel.advance(9ms);
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{3}), values);
+
+	// When.
+	wheel.advance(1ms);
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{3, 1}), values);
+}
+
+TEST_F(TimedSignalTest, debounce_thenOnlyLatestInvokedAfterQuietPeriod) {
+	// Given.
+	mw::TimedSignal<int> signal{wheel};
+	signal.setDebounce(10ms);
+	std::vector<int> values;
+	auto connection = signal.connect([&](int value) {
+		values.push_back(value);
+	});
+
+	// When.
+	for (int i = 0; i < 5; ++i) {
+		signal(i);
+		wheel.advance(5ms);
+	}
+
+	// Then.
+	EXPECT_TRUE(values.empty());
+
+	// When.
+	wheel.advance(5ms);
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{4}), values);
+}
+
+TEST_F(TimedSignalTest, throttle_thenFirstImmediateAndLatestAtEndOfWindow) {
+	// Given.
+	mw::TimedSignal<int> signal{wheel};
+	signal.setThrottle(10ms);
+	std::vector<int> values;
+	auto connection = signal.connect([&](int value) {
+		values.push_back(value);
+	});
+
+	// When.
+	signal(1);
+	signal(2);
+	signal(3);
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{1}), values);
+
+	// When.
+	wheel.advance(10ms);
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{1, 3}), values);
+
+	// When.
+	signal(4);
+	wheel.advance(10ms);
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{1, 3, 4}), values);
+
+	// When.
+	wheel.advance(10ms);
+	signal(5);
+
+	// Then.
+	EXPECT_EQ((std::vector<int>{1, 3, 4, 5}), values);
+}
+
+TEST_F(TimedSignalTest, signalDestroyed_thenPendingEmissionsAreDropped) {
+	// Given.
+	int invoked = 0;
+	{
+		mw::TimedSignal<> signal{wheel};
+		signal.setDebounce(5ms);
+		auto connection = signal.connect([&]() { ++invoked; });
+		signal.emitAfter(5ms);
+		signal();
+	}
+
+	// When.
+	wheel.advance(10ms);
+
+	// Then.
+	EXPECT_EQ(0, invoked);
+	EXPECT_EQ(0, wheel.size());
+}
+
+TEST_F(TimedSignalTest, moveAssigned_thenPendingTimerOfOverwrittenSignalIsCanceled) {
+	// Given.
+	int invoked = 0;
+	mw::TimedSignal<> signal{wheel};
+	mw::TimedSignal<> other{wheel};
+	signal.setDebounce(5ms);
+	auto connection = signal.connect([&]() { ++invoked; });
+	signal();
+
+	// When.
+	signal = std::move(other);
+	wheel.advance(10ms);
+
+	// Then.
+	EXPECT_EQ(0, invoked);
+	EXPECT_EQ(0, wheel.size());
+}
+
+TEST_F(TimedSignalTest, timerRescheduled_thenFiresAfterNewDelayOnce) {
+	// Given.
+	int fired = 0;
+	auto id = wheel.schedule(5ms, [&]() { ++fired; });
+	wheel.advance(4ms);
+
+	// When.
+	bool rescheduled = wheel.reschedule(id, 5ms);
+	wheel.advance(4ms);
+
+	// Then.
+	EXPECT_TRUE(rescheduled);
+	EXPECT_EQ(0, fired);
+
+	// When.
+	wheel.advance(1ms);
+
+	// Then.
+	EXPECT_EQ(1, fired);
+	EXPECT_FALSE(wheel.reschedule(id, 5ms));
+	EXPECT_EQ(0, wheel.size());
+}
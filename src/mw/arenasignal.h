@@ -0,0 +1,390 @@
+#ifndef SIGNAL_MW_ARENASIGNAL_H
+#define SIGNAL_MW_ARENASIGNAL_H
+
+#include "signal.h"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mw {
+
+	namespace signals {
+
+		/// @brief Bump allocator handing out memory from a list of blocks that never move.
+		class Arena {
+		public:
+			static constexpr std::size_t DefaultBlockSize = 16 * 1024;
+
+			Arena() = default;
+
+			Arena(const Arena&) = delete;
+			Arena& operator=(const Arena&) = delete;
+
+			Arena(Arena&&) noexcept = default;
+			Arena& operator=(Arena&&) noexcept = default;
+
+			void* allocate(std::size_t size, std::size_t alignment) {
+				if (blocks_.empty() || !fits(blocks_.back(), size, alignment)) {
+					auto capacity = std::max(DefaultBlockSize, size + alignment);
+					detail::trackAllocation(capacity);
+					blocks_.push_back({std::make_unique<std::byte[]>(capacity), capacity, 0});
+				}
+				auto& block = blocks_.back();
+				auto offset = align(block.used, alignment);
+				block.used = offset + size;
+				used_ += size;
+				return block.data.get() + offset;
+			}
+
+			/// @brief Marks memory as unused. The memory is reclaimed by the owner when compacting.
+			void release(std::size_t size) noexcept {
+				released_ += size;
+			}
+
+			void clear() noexcept {
+				blocks_.clear();
+				used_ = 0;
+				released_ = 0;
+			}
+
+			/// @brief Return true if more than half of the allocated memory is released.
+			bool fragmented() const noexcept {
+				return released_ > 0 && released_ * 2 > used_;
+			}
+
+		private:
+			struct Block {
+				std::unique_ptr<std::byte[]> data;
+				std::size_t capacity;
+				std::size_t used;
+			};
+
+			static std::size_t align(std::size_t offset, std::size_t alignment) noexcept {
+				return (offset + alignment - 1) & ~(alignment - 1);
+			}
+
+			static bool fits(const Block& block, std::size_t size, std::size_t alignment) noexcept {
+				return align(block.used, alignment) + size <= block.capacity;
+			}
+
+			TrackedVector<Block> blocks_;
+			std::size_t used_ = 0;
+			std::size_t released_ = 0;
+		};
+
+	}
+
+	/// @brief Same interface as Signal, but the slot callables are stored by value back-to-back
+	/// in a contiguous arena instead of behind a std::function each. Emission walks a compact
+	/// table of invoke thunks in arena order, the connection keys are kept in a separate cold
+	/// table only used when connecting and disconnecting. Not thread safe.
+	/// @tparam ...Args the slots invoke arguments
+	template <typename... Args>
+	class ArenaSignal : public signals::Connection::SignalInterface {
+	public:
+		ArenaSignal() = default;
+		~ArenaSignal();
+
+		ArenaSignal(const ArenaSignal&) = delete;
+		ArenaSignal& operator=(const ArenaSignal&) = delete;
+
+		ArenaSignal(ArenaSignal&&) noexcept;
+		ArenaSignal& operator=(ArenaSignal&&) noexcept;
+
+		template <typename Callback>
+			requires std::invocable<std::decay_t<Callback>&, Args...>
+		[[nodiscard]] signals::Connection connect(Callback&& callback);
+
+		template <typename T, typename... TArgs>
+		[[nodiscard]] signals::Connection connect(T* object, void(T::* ptr)(TArgs... args)) {
+			return connect([object, ptr](Args... args) {
+				(object->*ptr)(args...);
+			});
+		}
+
+		template <typename... Params>
+		void operator()(Params&&... params) {
+			invoke(std::forward<Params>(params)...);
+		}
+
+		template <typename... Params>
+		void invoke(Params&&... params);
+
+		void clear();
+
+		int size() const noexcept;
+
+		bool empty() const noexcept;
+
+	private:
+		using KeyPtr = signals::Connection::KeyPtr;
+		using InvokeFunction = void (*)(void*, Args...);
+		using DestroyFunction = void (*)(void*);
+		using RelocateFunction = void* (*)(void*, signals::Arena&);
+
+		void disconnect(const signals::Connection::Key& key) override;
+
+		void destroy(std::size_t index);
+		void removeDisconnected();
+		void compact();
+
+		// Destroys what was disconnected or replaced while invoking.
+		void invokeDone();
+
+		template <typename F>
+		static void invokeSlot(void* object, Args... args) {
+			(*static_cast<F*>(object))(std::forward<Args>(args)...);
+		}
+
+		template <typename F>
+		static void destroySlot(void* object) {
+			static_cast<F*>(object)->~F();
+		}
+
+		template <typename F>
+		static void* relocateSlot(void* object, signals::Arena& arena) {
+			auto f = static_cast<F*>(object);
+			auto moved = ::new (arena.allocate(sizeof(F), alignof(F))) F(std::move(*f));
+			f->~F();
+			return moved;
+		}
+
+		// Hot data, the only thing touched during emission.
+		struct Slot {
+			void* object;
+			InvokeFunction invoke; // Null when disconnected during emission.
+		};
+
+		// Cold data, only used when connecting and disconnecting.
+		struct SlotInfo {
+			KeyPtr key;
+			DestroyFunction destroy;
+			RelocateFunction relocate;
+			std::size_t size;
+		};
+
+		// Slots replaced by a move assignment during invoke, one of them may be executing.
+		struct Retired {
+			signals::TrackedVector<Slot> slots;
+			signals::TrackedVector<SlotInfo> infos;
+			signals::Arena arena;
+		};
+
+		// Keeps track of nested invokes and cleans up when the outermost is done, also if a slot throws.
+		class InvokeGuard {
+		public:
+			explicit InvokeGuard(ArenaSignal& signal) noexcept
+				: signal_{signal} {
+				++signal_.invoking_;
+			}
+
+			~InvokeGuard() {
+				if (--signal_.invoking_ == 0) {
+					signal_.invokeDone();
+				}
+			}
+
+			InvokeGuard(const InvokeGuard&) = delete;
+			InvokeGuard& operator=(const InvokeGuard&) = delete;
+
+		private:
+			ArenaSignal& signal_;
+		};
+
+		signals::TrackedVector<Slot> slots_;
+		signals::TrackedVector<SlotInfo> infos_;
+		signals::Arena arena_;
+		signals::TrackedVector<Retired> retired_;
+		int size_ = 0;
+		int invoking_ = 0;
+		unsigned generation_ = 0; // Changed when moved from or assigned to, ends invokes of the moved or replaced slots.
+	};
+
+	// ------------ Definitions ------------
+
+	template <typename... Args>
+	ArenaSignal<Args...>::~ArenaSignal() {
+		clear();
+	}
+
+	template <typename... Args>
+	ArenaSignal<Args...>::ArenaSignal(ArenaSignal&& signal) noexcept
+		: slots_{std::move(signal.slots_)}
+		, infos_{std::move(signal.infos_)}
+		, arena_{std::move(signal.arena_)}
+		, size_{std::exchange(signal.size_, 0)} {
+
+		++signal.generation_;
+		for (auto& info : infos_) {
+			if (info.key) {
+				info.key->signal.store(this, std::memory_order_release);
+			}
+		}
+		signal.clear();
+	}
+
+	template <typename... Args>
+	ArenaSignal<Args...>& ArenaSignal<Args...>::operator=(ArenaSignal&& signal) noexcept {
+		if (this != &signal) {
+			clear();
+			if (invoking_ > 0) {
+				// The replaced slots are destroyed when the invoke is done.
+				retired_.push_back({std::move(slots_), std::move(infos_), std::move(arena_)});
+				++generation_;
+			}
+			slots_ = std::move(signal.slots_);
+			infos_ = std::move(signal.infos_);
+			arena_ = std::move(signal.arena_);
+			size_ = std::exchange(signal.size_, 0);
+			++signal.generation_;
+
+			for (auto& info : infos_) {
+				if (info.key) {
+					info.key->signal.store(this, std::memory_order_release);
+				}
+			}
+			signal.clear();
+		}
+		return *this;
+	}
+
+	template <typename... Args>
+	template <typename Callback>
+		requires std::invocable<std::decay_t<Callback>&, Args...>
+	signals::Connection ArenaSignal<Args...>::connect(Callback&& callback) {
+		using F = std::decay_t<Callback>;
+		static_assert(alignof(F) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Over-aligned callables are not supported");
+
+		signals::detail::AllocationScope scope{this};
+		auto object = ::new (arena_.allocate(sizeof(F), alignof(F))) F(std::forward<Callback>(callback));
+		auto key = signals::detail::makeShared<signals::Connection::Key>(this);
+		slots_.push_back({object, &invokeSlot<F>});
+		infos_.push_back({key, &destroySlot<F>, &relocateSlot<F>, sizeof(F)});
+		++size_;
+		return signals::Connection(key);
+	}
+
+	template <typename... Args>
+	template <typename... Params>
+	void ArenaSignal<Args...>::invoke(Params&&... a) {
+		InvokeGuard guard{*this};
+		const auto size = slots_.size();
+		const auto generation = generation_;
+		// Slots connected during emission are appended after size and not invoked.
+		for (std::size_t i = 0; i < size && i < slots_.size() && generation == generation_; ++i) {
+			const auto slot = slots_[i];
+			if (slot.invoke != nullptr) {
+				slot.invoke(slot.object, a...);
+			}
+		}
+	}
+
+	template <typename... Args>
+	void ArenaSignal<Args...>::clear() {
+		for (std::size_t i = 0; i < slots_.size(); ++i) {
+			infos_[i].key->signal.store(nullptr, std::memory_order_release);
+			if (invoking_ == 0) {
+				infos_[i].destroy(slots_[i].object);
+			} else {
+				slots_[i].invoke = nullptr;
+			}
+		}
+		size_ = 0;
+		if (invoking_ == 0) {
+			slots_.clear();
+			infos_.clear();
+			arena_.clear();
+		}
+	}
+
+	template <typename... Args>
+	int ArenaSignal<Args...>::size() const noexcept {
+		return size_;
+	}
+
+	template <typename... Args>
+	bool ArenaSignal<Args...>::empty() const noexcept {
+		return size_ == 0;
+	}
+
+	template <typename... Args>
+	void ArenaSignal<Args...>::disconnect(const signals::Connection::Key& key) {
+		auto it = std::find_if(infos_.begin(), infos_.end(), [&key](const SlotInfo& info) {
+			return info.key.get() == &key;
+		});
+		if (it == infos_.end()) {
+			return;
+		}
+		const auto index = static_cast<std::size_t>(it - infos_.begin());
+		it->key->signal.store(nullptr, std::memory_order_release);
+		--size_;
+		if (invoking_ > 0) {
+			// The callable may be executing, it is destroyed when the emission is done.
+			slots_[index].invoke = nullptr;
+			return;
+		}
+		destroy(index);
+		slots_.erase(slots_.begin() + index);
+		infos_.erase(it);
+		if (arena_.fragmented()) {
+			compact();
+		}
+	}
+
+	template <typename... Args>
+	void ArenaSignal<Args...>::destroy(std::size_t index) {
+		infos_[index].destroy(slots_[index].object);
+		arena_.release(infos_[index].size);
+	}
+
+	template <typename... Args>
+	void ArenaSignal<Args...>::removeDisconnected() {
+		std::size_t alive = 0;
+		for (std::size_t i = 0; i < slots_.size(); ++i) {
+			if (slots_[i].invoke == nullptr) {
+				destroy(i);
+			} else {
+				slots_[alive] = slots_[i];
+				infos_[alive] = std::move(infos_[i]);
+				++alive;
+			}
+		}
+		slots_.resize(alive);
+		infos_.resize(alive);
+		if (arena_.fragmented()) {
+			compact();
+		}
+	}
+
+	template <typename... Args>
+	void ArenaSignal<Args...>::invokeDone() {
+		for (auto& retired : retired_) {
+			for (std::size_t i = 0; i < retired.slots.size(); ++i) {
+				retired.infos[i].destroy(retired.slots[i].object);
+			}
+		}
+		retired_.clear();
+		if (size_ != static_cast<int>(slots_.size())) {
+			removeDisconnected();
+		}
+	}
+
+	template <typename... Args>
+	void ArenaSignal<Args...>::compact() {
+		signals::detail::AllocationScope scope{this};
+		signals::Arena arena;
+		for (std::size_t i = 0; i < slots_.size(); ++i) {
+			slots_[i].object = infos_[i].relocate(slots_[i].object, arena);
+		}
+		arena_ = std::move(arena);
+	}
+
+}
+
+#endif
@@ -0,0 +1,357 @@
+#ifndef SIGNAL_MW_COMPACTSIGNAL_H
+#define SIGNAL_MW_COMPACTSIGNAL_H
+
+#include "signal.h"
+
+#include <memory>
+#include <utility>
+
+namespace mw {
+
+	/// @brief Same interface as Signal, but the size of a single pointer, which is null until the
+	/// first connect and again after the last slot is disconnected. The slots live in a heap block
+	/// holding the first two slots inline, more slots spill to segmented storage. Meant for objects
+	/// with many mostly unconnected signals. Moving only moves the pointer. Not thread safe.
+	/// @tparam ...Args the slots invoke arguments
+	template <typename... Args>
+	class CompactSignal {
+	public:
+		using Callback = std::function<void(Args...)>;
+
+		static constexpr size_t InlineSlots = 2;
+
+		CompactSignal() noexcept = default;
+
+		~CompactSignal() {
+			clear();
+			release();
+		}
+
+		CompactSignal(const CompactSignal&) = delete;
+		CompactSignal& operator=(const CompactSignal&) = delete;
+
+		CompactSignal(CompactSignal&& signal) noexcept
+			: storage_{std::move(signal.storage_)} {
+			if (storage_) {
+				storage_->owner = this;
+			}
+		}
+
+		/// @brief May be called from one of the signal's own slots, the replaced storage is
+		/// destroyed when the invoke is done.
+		CompactSignal& operator=(CompactSignal&& signal) noexcept {
+			if (this != &signal) {
+				clear();
+				release();
+				storage_ = std::move(signal.storage_);
+				if (storage_) {
+					storage_->owner = this;
+				}
+			}
+			return *this;
+		}
+
+		[[nodiscard]] signals::Connection connect(const Callback& callback) {
+			return connectSlot(callback);
+		}
+
+		/// @brief Moves the callable directly into the slot storage. Move-only callables are allowed.
+		template <typename F>
+			requires (!std::same_as<std::remove_cvref_t<F>, Callback> && std::invocable<std::decay_t<F>&, Args...>)
+		[[nodiscard]] signals::Connection connect(F&& callback) {
+			return connectSlot(std::forward<F>(callback));
+		}
+
+		template <typename T, typename... TArgs>
+		[[nodiscard]] signals::Connection connect(T* object, void(T::* ptr)(TArgs... args)) {
+			return connect([object, ptr](Args... args) {
+				(object->*ptr)(args...);
+			});
+		}
+
+		template <typename... Params>
+		void operator()(Params&&... params) {
+			invoke(std::forward<Params>(params)...);
+		}
+
+		template <typename... Params>
+		void invoke(Params&&... params) {
+			if (storage_) {
+				storage_->invoke(params...);
+			}
+		}
+
+		/// @brief Removes all connections and releases the slot storage.
+		void clear();
+
+		int size() const noexcept {
+			return storage_ ? static_cast<int>(storage_->size) : 0;
+		}
+
+		bool empty() const noexcept {
+			return size() == 0;
+		}
+
+		/// @brief Return the approximate number of bytes used by the signal, the slot storage and
+		/// the connection keys. Each key is counted with an approximate size while its slot is
+		/// connected, keys kept alive by Connection objects after a disconnect are not included.
+		/// Memory allocated by the callbacks themselves is not included.
+		size_t memoryUsage() const noexcept;
+
+	private:
+		using KeyPtr = signals::Connection::KeyPtr;
+
+		struct KeyCallback {
+			KeyPtr key; // Null when disconnected during invoke, removed afterwards.
+			signals::MoveOnlyFunction<void(Args...)> callback;
+		};
+
+		template <typename F>
+		signals::Connection connectSlot(F&& callback);
+
+		// Releases the storage. An invoking storage is handed over to the invoke, which destroys it when done.
+		void release() noexcept;
+
+		// The connection keys point to the storage, which never moves.
+		class Storage final : public signals::Connection::SignalInterface {
+		public:
+			explicit Storage(CompactSignal& owner) noexcept
+				: owner{&owner} {
+			}
+
+			KeyCallback& operator[](size_t index) noexcept {
+				return index < InlineSlots ? inline_[index] : overflow_[index - InlineSlots];
+			}
+
+			void push_back(KeyCallback&& keyCallback) {
+				if (count < InlineSlots) {
+					inline_[count] = std::move(keyCallback);
+				} else {
+					overflow_.emplace_back(std::move(keyCallback));
+				}
+				++count;
+				++size;
+			}
+
+			template <typename... Params>
+			void invoke(Params&... params) {
+				InvokeGuard guard{*this};
+				// Callbacks added during iteration are placed after current count and are not invoked.
+				const auto current = count;
+				for (size_t i = 0; i < current; ++i) {
+					auto& keyCallback = (*this)[i];
+					if (keyCallback.key) {
+						keyCallback.callback(params...);
+					}
+				}
+			}
+
+			void disconnectAll() {
+				for (size_t i = 0; i < count; ++i) {
+					auto& keyCallback = (*this)[i];
+					if (keyCallback.key) {
+						keyCallback.key->signal.store(nullptr, std::memory_order_release);
+						keyCallback.key = nullptr;
+					}
+				}
+				size = 0;
+			}
+
+			size_t memoryUsage() const noexcept {
+				return sizeof(Storage)
+					+ overflow_.memoryUsage()
+					+ size * signals::Connection::KeyMemoryUsage;
+			}
+
+			CompactSignal* owner; // Updated when the signal moves, null when released during invoke.
+			size_t count = 0; // Slots in use, disconnected ones waiting for removal included.
+			size_t size = 0;
+			int invoking = 0;
+
+		private:
+			// Keeps track of nested invokes and cleans up when the outermost is done, also if a slot throws.
+			class InvokeGuard {
+			public:
+				explicit InvokeGuard(Storage& storage) noexcept
+					: storage_{storage} {
+					++storage_.invoking;
+				}
+
+				~InvokeGuard() {
+					if (--storage_.invoking == 0) {
+						storage_.invokeDone(); // May destroy the storage, nothing may follow.
+					}
+				}
+
+				InvokeGuard(const InvokeGuard&) = delete;
+				InvokeGuard& operator=(const InvokeGuard&) = delete;
+
+			private:
+				Storage& storage_;
+			};
+
+			// Removes the slots disconnected during invoke, and releases the storage if none is left.
+			void invokeDone() {
+				if (size != count) {
+					removeDisconnected();
+				}
+				if (size == 0) {
+					// Destroys this, nothing may follow.
+					if (owner == nullptr) {
+						delete this;
+					} else {
+						owner->storage_.reset();
+					}
+				}
+			}
+
+			void disconnect(const signals::Connection::Key& key) override {
+				for (size_t i = 0; i < count; ++i) {
+					auto& keyCallback = (*this)[i];
+					if (keyCallback.key.get() == &key) {
+						keyCallback.key->signal.store(nullptr, std::memory_order_release);
+						keyCallback.key = nullptr;
+						--size;
+						if (invoking == 0) {
+							removeDisconnected();
+							if (size == 0) {
+								owner->storage_.reset(); // Destroys this, nothing may follow.
+							}
+						}
+						return;
+					}
+				}
+			}
+
+			void removeDisconnected() {
+				size_t alive = 0;
+				for (size_t i = 0; i < count; ++i) {
+					auto& keyCallback = (*this)[i];
+					if (keyCallback.key) {
+						if (alive != i) {
+							(*this)[alive] = std::move(keyCallback);
+						}
+						++alive;
+					}
+				}
+				for (size_t i = alive; i < InlineSlots && i < count; ++i) {
+					inline_[i] = {};
+				}
+				while (overflow_.size() + InlineSlots > std::max(alive, InlineSlots)) {
+					overflow_.pop_back();
+				}
+				count = alive;
+			}
+
+			KeyCallback inline_[InlineSlots];
+			signals::SegmentedVector<KeyCallback> overflow_;
+		};
+
+		std::unique_ptr<Storage> storage_;
+	};
+
+	/// @brief Can be used as public member of a class, like PublicSignal but with the footprint
+	/// of CompactSignal.
+	/// @tparam Friend the class that contains all functionality of the underlaying signal object
+	/// @tparam ...Args the slots invoke arguments
+	template <typename Friend, typename... Args>
+	class PublicCompactSignal {
+	public:
+		using Callback = typename CompactSignal<Args...>::Callback;
+
+		friend Friend;
+
+		[[nodiscard]]
+		signals::Connection connect(const Callback& callback) {
+			return signal_.connect(callback);
+		}
+
+		template <typename F>
+			requires (!std::same_as<std::remove_cvref_t<F>, Callback> && std::invocable<std::decay_t<F>&, Args...>)
+		[[nodiscard]] signals::Connection connect(F&& callback) {
+			return signal_.connect(std::forward<F>(callback));
+		}
+
+		template <typename T, typename... TArgs>
+		[[nodiscard]] signals::Connection connect(T* object, void(T::* ptr)(TArgs... args)) {
+			return signal_.connect(object, ptr);
+		}
+
+		size_t memoryUsage() const noexcept {
+			return signal_.memoryUsage();
+		}
+
+	private:
+		PublicCompactSignal() = default;
+		PublicCompactSignal(const PublicCompactSignal&) = delete;
+		PublicCompactSignal& operator=(const PublicCompactSignal&) = delete;
+		PublicCompactSignal(PublicCompactSignal&&) noexcept = default;
+		PublicCompactSignal& operator=(PublicCompactSignal&&) noexcept = default;
+
+		template <typename... Params>
+		void operator()(Params&&... params) {
+			signal_.invoke(std::forward<Params>(params)...);
+		}
+
+		template <typename... Params>
+		void invoke(Params&&... params) {
+			signal_.invoke(std::forward<Params>(params)...);
+		}
+
+		void clear() {
+			signal_.clear();
+		}
+
+		int size() const noexcept {
+			return signal_.size();
+		}
+
+		bool empty() const noexcept {
+			return signal_.empty();
+		}
+
+		CompactSignal<Args...> signal_;
+	};
+
+	// ------------ Definitions ------------
+
+	template <typename... Args>
+	template <typename F>
+	signals::Connection CompactSignal<Args...>::connectSlot(F&& callback) {
+		signals::detail::AllocationScope scope{this};
+		if (!storage_) {
+			storage_ = signals::detail::makeUnique<Storage>(*this);
+		}
+		auto c = signals::detail::makeShared<signals::Connection::Key>(storage_.get());
+		storage_->push_back(KeyCallback{c, std::forward<F>(callback)});
+		return signals::Connection(c);
+	}
+
+	template <typename... Args>
+	void CompactSignal<Args...>::clear() {
+		if (!storage_) {
+			return;
+		}
+		storage_->disconnectAll();
+		if (storage_->invoking == 0) {
+			storage_.reset();
+		}
+	}
+
+	template <typename... Args>
+	void CompactSignal<Args...>::release() noexcept {
+		if (storage_ && storage_->invoking > 0) {
+			storage_.release()->owner = nullptr;
+		} else {
+			storage_.reset();
+		}
+	}
+
+	template <typename... Args>
+	size_t CompactSignal<Args...>::memoryUsage() const noexcept {
+		return sizeof(CompactSignal) + (storage_ ? storage_->memoryUsage() : 0);
+	}
+
+}
+
+#endif
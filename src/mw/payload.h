@@ -0,0 +1,227 @@
+#ifndef SIGNAL_MW_PAYLOAD_H
+#define SIGNAL_MW_PAYLOAD_H
+
+#include "signal.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace mw {
+
+	template <typename T>
+	class PayloadPool;
+
+	/// @brief Shared handle to an immutable value taken from a PayloadPool. Copying the handle
+	/// only increments an atomic reference count, the value is returned to the pool when the last
+	/// handle is destroyed. Handles may be copied and destroyed on any thread.
+	///
+	/// Signal<Payload<T>> delivers the same instance to every slot. Slots taking const T& are
+	/// called through the implicit conversion, slots deferring the work to another thread take
+	/// the Payload<T> by value and keep it alive until done.
+	/// @tparam T the value type
+	template <typename T>
+	class Payload {
+	public:
+		Payload() noexcept = default;
+
+		~Payload() {
+			release();
+		}
+
+		Payload(const Payload& payload) noexcept
+			: node_{payload.node_} {
+			if (node_ != nullptr) {
+				node_->refs.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		Payload& operator=(const Payload& payload) noexcept {
+			Payload{payload}.swap(*this);
+			return *this;
+		}
+
+		Payload(Payload&& payload) noexcept
+			: node_{std::exchange(payload.node_, nullptr)} {
+		}
+
+		Payload& operator=(Payload&& payload) noexcept {
+			Payload{std::move(payload)}.swap(*this);
+			return *this;
+		}
+
+		void swap(Payload& payload) noexcept {
+			std::swap(node_, payload.node_);
+		}
+
+		const T& get() const noexcept {
+			return node_->value;
+		}
+
+		operator const T&() const noexcept {
+			return node_->value;
+		}
+
+		const T& operator*() const noexcept {
+			return node_->value;
+		}
+
+		const T* operator->() const noexcept {
+			return &node_->value;
+		}
+
+		explicit operator bool() const noexcept {
+			return node_ != nullptr;
+		}
+
+		/// @brief Return the number of handles sharing the value. Only exact when no other
+		/// thread copies or destroys handles at the same time.
+		int useCount() const noexcept {
+			return node_ != nullptr ? node_->refs.load(std::memory_order_relaxed) : 0;
+		}
+
+	private:
+		friend class PayloadPool<T>;
+
+		struct State;
+
+		struct Node {
+			T value{};
+			std::atomic<int> refs{0};
+			std::shared_ptr<State> state; // Set once when the node is created, nodes are reused.
+		};
+
+		// Owned by the pool and by every node, so the nodes can be returned after the pool is gone.
+		struct State {
+			~State() {
+				for (auto node : free) {
+					delete node;
+				}
+			}
+
+			std::mutex mutex;
+			signals::TrackedVector<Node*> free;
+			bool closed = false; // The pool is destroyed, returned nodes are deleted.
+		};
+
+		explicit Payload(Node* node) noexcept
+			: node_{node} {
+		}
+
+		void release() noexcept {
+			if (node_ == nullptr || node_->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+				return;
+			}
+			auto node = std::exchange(node_, nullptr);
+			auto state = node->state; // Keeps the mutex alive if the node is deleted below.
+			std::unique_lock lock{state->mutex};
+			if (state->closed) {
+				lock.unlock();
+				delete node;
+			} else {
+				state->free.push_back(node);
+			}
+		}
+
+		Node* node_ = nullptr;
+	};
+
+	/// @brief Recycles the values of Payload handles. A value is filled in place by acquire(), so
+	/// a value keeping its buffers between uses (e.g. std::vector) is reused without allocations
+	/// in steady state. Thread safe.
+	/// @tparam T the value type, must be default constructible
+	template <typename T>
+	class PayloadPool {
+	public:
+		PayloadPool()
+			: state_{signals::detail::makeShared<State>()} {
+		}
+
+		~PayloadPool() {
+			signals::TrackedVector<Node*> free;
+			{
+				std::scoped_lock lock{state_->mutex};
+				state_->closed = true;
+				free.swap(state_->free);
+			}
+			for (auto node : free) {
+				delete node;
+			}
+		}
+
+		PayloadPool(const PayloadPool&) = delete;
+		PayloadPool& operator=(const PayloadPool&) = delete;
+
+		/// @brief Takes a value from the pool, or creates one if empty, and lets fill write to it.
+		/// The value still holds the content from its previous use and fill must overwrite it.
+		/// @param fill called as fill(T&) before the value becomes immutable
+		template <typename Fill>
+		Payload<T> acquire(Fill&& fill) {
+			auto node = take();
+			try {
+				fill(node->value);
+			} catch (...) {
+				giveBack(node);
+				throw;
+			}
+			node->refs.store(1, std::memory_order_relaxed);
+			return Payload<T>{node};
+		}
+
+		/// @brief Assigns the value to a value taken from the pool.
+		Payload<T> acquire(const T& value) {
+			return acquire([&value](T& pooled) {
+				pooled = value;
+			});
+		}
+
+		/// @brief Creates values up to the given number of unused ones in the pool.
+		void reserve(std::size_t size) {
+			std::scoped_lock lock{state_->mutex};
+			state_->free.reserve(size);
+			while (state_->free.size() < size) {
+				state_->free.push_back(create());
+			}
+		}
+
+		/// @brief Return the number of unused values in the pool.
+		std::size_t available() const {
+			std::scoped_lock lock{state_->mutex};
+			return state_->free.size();
+		}
+
+	private:
+		using Node = typename Payload<T>::Node;
+		using State = typename Payload<T>::State;
+
+		Node* create() {
+			auto node = signals::detail::makeUnique<Node>();
+			node->state = state_;
+			return node.release();
+		}
+
+		Node* take() {
+			{
+				std::scoped_lock lock{state_->mutex};
+				if (!state_->free.empty()) {
+					auto node = state_->free.back();
+					state_->free.pop_back();
+					return node;
+				}
+			}
+			return create();
+		}
+
+		void giveBack(Node* node) {
+			std::scoped_lock lock{state_->mutex};
+			state_->free.push_back(node);
+		}
+
+		std::shared_ptr<State> state_;
+	};
+
+}
+
+#endif
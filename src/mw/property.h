@@ -0,0 +1,232 @@
+#ifndef SIGNAL_MW_PROPERTY_H
+#define SIGNAL_MW_PROPERTY_H
+
+#include "signal.h"
+
+#include <functional>
+#include <utility>
+
+namespace mw {
+
+	enum class PropertyMode {
+		Immediate,	// Slots are invoked on every change.
+		Deferred	// Changes mark the property dirty, slots are invoked once by flush().
+	};
+
+	/// @brief Owns a value and invokes its slots only when the value actually changes.
+	/// Not thread safe.
+	/// @tparam T the value type
+	/// @tparam Equal compares the old and the new value, no notification when equal
+	template <typename T, typename Equal = std::equal_to<T>>
+	class Property {
+	public:
+		using Callback = typename Signal<const T&>::Callback;
+
+		Property() = default;
+
+		explicit Property(T value, PropertyMode mode = PropertyMode::Immediate, Equal equal = {})
+			: value_{std::move(value)}
+			, equal_{std::move(equal)}
+			, mode_{mode} {
+		}
+
+		Property(const Property&) = delete;
+		Property& operator=(const Property&) = delete;
+
+		Property(Property&&) noexcept = default;
+		Property& operator=(Property&&) noexcept = default;
+
+		/// @brief Assigns the value, the slots are invoked if it differs from the current value.
+		/// @return true if the value changed.
+		template <typename U = T>
+		bool set(U&& value);
+
+		Property& operator=(const T& value) {
+			set(value);
+			return *this;
+		}
+
+		Property& operator=(T&& value) {
+			set(std::move(value));
+			return *this;
+		}
+
+		const T& get() const noexcept {
+			return value_;
+		}
+
+		operator const T&() const noexcept {
+			return value_;
+		}
+
+		const T& operator*() const noexcept {
+			return value_;
+		}
+
+		const T* operator->() const noexcept {
+			return &value_;
+		}
+
+		/// @brief In deferred mode, invokes the slots once if the value differs from the value
+		/// they were last invoked with, i.e. changing A to B and back to A notifies nothing.
+		void flush();
+
+		/// @brief Return true if the value differs from the last notified one and waits for flush().
+		bool dirty() const noexcept {
+			return dirty_;
+		}
+
+		PropertyMode mode() const noexcept {
+			return mode_;
+		}
+
+		[[nodiscard]] signals::Connection connect(const Callback& callback) {
+			return changed_.connect(callback);
+		}
+
+		template <typename C, typename... TArgs>
+		[[nodiscard]] signals::Connection connect(C* object, void(C::* ptr)(TArgs... args)) {
+			return changed_.connect(object, ptr);
+		}
+
+		void clear() {
+			changed_.clear();
+		}
+
+		int size() const noexcept {
+			return changed_.size();
+		}
+
+		bool empty() const noexcept {
+			return changed_.empty();
+		}
+
+	private:
+		T value_{};
+		T notified_{}; // Deferred mode, the value the slots last saw. Only valid while dirty.
+		[[no_unique_address]] Equal equal_{};
+		PropertyMode mode_ = PropertyMode::Immediate;
+		bool dirty_ = false;
+		Signal<const T&> changed_;
+	};
+
+	/// @brief A Property where only the Friend class can change the value and flush.
+	/// @tparam Friend the class owning the value
+	/// @tparam T the value type
+	/// @tparam Equal compares the old and the new value, no notification when equal
+	template <typename Friend, typename T, typename Equal = std::equal_to<T>>
+	class PublicProperty {
+	public:
+		using Callback = typename Property<T, Equal>::Callback;
+
+		friend Friend;
+
+		const T& get() const noexcept {
+			return property_.get();
+		}
+
+		operator const T&() const noexcept {
+			return property_.get();
+		}
+
+		const T& operator*() const noexcept {
+			return property_.get();
+		}
+
+		const T* operator->() const noexcept {
+			return &property_.get();
+		}
+
+		[[nodiscard]]
+		signals::Connection connect(const Callback& callback) {
+			return property_.connect(callback);
+		}
+
+		template <typename C, typename... TArgs>
+		[[nodiscard]] signals::Connection connect(C* object, void(C::* ptr)(TArgs... args)) {
+			return property_.connect(object, ptr);
+		}
+
+	private:
+		PublicProperty() = default;
+
+		explicit PublicProperty(T value, PropertyMode mode = PropertyMode::Immediate, Equal equal = {})
+			: property_{std::move(value), mode, std::move(equal)} {
+		}
+
+		PublicProperty(const PublicProperty&) = delete;
+		PublicProperty& operator=(const PublicProperty&) = delete;
+		PublicProperty(PublicProperty&&) noexcept = default;
+		PublicProperty& operator=(PublicProperty&&) noexcept = default;
+
+		template <typename U = T>
+		bool set(U&& value) {
+			return property_.set(std::forward<U>(value));
+		}
+
+		PublicProperty& operator=(const T& value) {
+			property_.set(value);
+			return *this;
+		}
+
+		PublicProperty& operator=(T&& value) {
+			property_.set(std::move(value));
+			return *this;
+		}
+
+		void flush() {
+			property_.flush();
+		}
+
+		bool dirty() const noexcept {
+			return property_.dirty();
+		}
+
+		void clear() {
+			property_.clear();
+		}
+
+		int size() const noexcept {
+			return property_.size();
+		}
+
+		bool empty() const noexcept {
+			return property_.empty();
+		}
+
+		Property<T, Equal> property_;
+	};
+
+	// ------------ Definitions ------------
+
+	template <typename T, typename Equal>
+	template <typename U>
+	bool Property<T, Equal>::set(U&& value) {
+		if (std::invoke(equal_, std::as_const(value_), std::as_const(value))) {
+			return false;
+		}
+		if (mode_ == PropertyMode::Immediate) {
+			value_ = std::forward<U>(value);
+			changed_.invoke(std::as_const(value_));
+		} else if (!dirty_) {
+			notified_ = std::move(value_);
+			value_ = std::forward<U>(value);
+			dirty_ = true;
+		} else {
+			value_ = std::forward<U>(value);
+			dirty_ = !std::invoke(equal_, std::as_const(notified_), std::as_const(value_));
+		}
+		return true;
+	}
+
+	template <typename T, typename Equal>
+	void Property<T, Equal>::flush() {
+		if (dirty_) {
+			dirty_ = false;
+			changed_.invoke(std::as_const(value_));
+		}
+	}
+
+}
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef SIGNAL_MW_REALTIMESIGNAL_H
+#define SIGNAL_MW_REALTIMESIGNAL_H
+
+#include "signal.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mw {
+
+	/// @brief A signal for one real-time emitting thread, e.g. an audio thread, and control
+	/// threads connecting and disconnecting slots. Invoke takes no locks, does not allocate and
+	/// only reads an immutable, published slot list. Control operations build a new list off to
+	/// the side, swap it in with an atomic exchange and defer destruction of the retired list,
+	/// including the callbacks, to a later control operation.
+	///
+	/// Connect, disconnect, clear and destruction must be made from control threads, never from
+	/// a slot. A slot disconnected during an ongoing invoke may be called by that invoke.
+	/// @tparam ...Args the slots invoke arguments
+	template <typename... Args>
+	class RealtimeSignal : public signals::Connection::SignalInterface {
+	public:
+		using Callback = std::function<void(Args...)>;
+
+		RealtimeSignal();
+		~RealtimeSignal();
+
+		RealtimeSignal(const RealtimeSignal&) = delete;
+		RealtimeSignal& operator=(const RealtimeSignal&) = delete;
+
+		RealtimeSignal(RealtimeSignal&&) = delete;
+		RealtimeSignal& operator=(RealtimeSignal&&) = delete;
+
+		/// @brief Control thread.
+		[[nodiscard]] signals::Connection connect(const Callback& callback);
+
+		template <typename T, typename... TArgs>
+		[[nodiscard]] signals::Connection connect(T* object, void(T::* ptr)(TArgs... args)) {
+			return connect([object, ptr](Args... args) {
+				(object->*ptr)(args...);
+			});
+		}
+
+		/// @brief Real-time thread. Lock-free and allocation free.
+		template <typename... Params>
+		void operator()(Params&&... params) {
+			invoke(std::forward<Params>(params)...);
+		}
+
+		/// @brief Real-time thread. Lock-free and allocation free.
+		template <typename... Params>
+		void invoke(Params&&... params);
+
+		/// @brief Control thread.
+		void clear();
+
+		/// @brief Control thread. Destroys the retired slot lists no longer read by the emitter.
+		void collect();
+
+		/// @brief Control thread.
+		int size() const;
+
+		/// @brief Control thread.
+		bool empty() const;
+
+	private:
+		using KeyPtr = signals::Connection::KeyPtr;
+
+		struct SlotList {
+			signals::TrackedVector<const Callback*> callbacks;
+		};
+
+		struct Slot {
+			KeyPtr key;
+			std::unique_ptr<const Callback> callback;
+		};
+
+		void disconnect(const signals::Connection::Key& key) override;
+
+		// Real-time thread. Sets the hazard pointer to the current list and emits from it.
+		void pin() noexcept;
+
+		// Real-time thread. Clears the hazard pointer, the list may be reclaimed.
+		void unpin() noexcept;
+
+		// Pins the list for the outermost invoke and unpins it when done, also if a slot throws.
+		class InvokeGuard {
+		public:
+			explicit InvokeGuard(RealtimeSignal& signal) noexcept
+				: signal_{signal} {
+				if (signal_.invoking_++ == 0) {
+					signal_.pin();
+				}
+			}
+
+			~InvokeGuard() {
+				if (--signal_.invoking_ == 0) {
+					signal_.unpin();
+				}
+			}
+
+			InvokeGuard(const InvokeGuard&) = delete;
+			InvokeGuard& operator=(const InvokeGuard&) = delete;
+
+		private:
+			RealtimeSignal& signal_;
+		};
+
+		// Publishes the control thread's slots as a new list for the emitter.
+		void publish();
+
+		void collectRetired();
+
+		std::unique_ptr<SlotList> takeSpare();
+
+		// Control thread data, guarded by mutex_.
+		mutable std::mutex mutex_;
+		signals::TrackedVector<Slot> slots_;
+		signals::TrackedVector<std::unique_ptr<SlotList>> retired_;
+		signals::TrackedVector<std::unique_ptr<const Callback>> retiredCallbacks_; // Until no retired list is read.
+		std::unique_ptr<SlotList> spare_;
+
+		// Shared between the control and real-time thread.
+		std::atomic<SlotList*> current_;
+		std::atomic<SlotList*> reading_{nullptr}; // Hazard pointer set by the emitter.
+
+		// Real-time thread data.
+		SlotList* emitting_ = nullptr;
+		int invoking_ = 0;
+	};
+
+	// ------------ Definitions ------------
+
+	template <typename... Args>
+	RealtimeSignal<Args...>::RealtimeSignal()
+		: current_{signals::detail::makeUnique<SlotList>().release()} {
+	}
+
+	template <typename... Args>
+	RealtimeSignal<Args...>::~RealtimeSignal() {
+		clear();
+		delete current_.load();
+	}
+
+	template <typename... Args>
+	signals::Connection RealtimeSignal<Args...>::connect(const Callback& callback) {
+		std::scoped_lock lock{mutex_};
+		signals::detail::AllocationScope scope{this};
+		auto c = signals::detail::makeShared<signals::Connection::Key>(this);
+		slots_.push_back({c, signals::detail::makeUnique<const Callback>(callback)});
+		publish();
+		return signals::Connection(c);
+	}
+
+	template <typename... Args>
+	template <typename... Params>
+	void RealtimeSignal<Args...>::invoke(Params&&... params) {
+		InvokeGuard guard{*this};
+		// Nested invokes reuse the list of the outermost invoke.
+		for (auto callback : emitting_->callbacks) {
+			(*callback)(params...);
+		}
+	}
+
+	template <typename... Args>
+	void RealtimeSignal<Args...>::pin() noexcept {
+		auto list = current_.load(std::memory_order_acquire);
+		reading_.store(list, std::memory_order_seq_cst);
+		// Retry if the list was retired before the hazard pointer was visible.
+		while (true) {
+			auto latest = current_.load(std::memory_order_seq_cst);
+			if (latest == list) {
+				break;
+			}
+			list = latest;
+			reading_.store(list, std::memory_order_seq_cst);
+		}
+		emitting_ = list;
+	}
+
+	template <typename... Args>
+	void RealtimeSignal<Args...>::unpin() noexcept {
+		emitting_ = nullptr;
+		reading_.store(nullptr, std::memory_order_release);
+	}
+
+	template <typename... Args>
+	void RealtimeSignal<Args...>::clear() {
+		std::scoped_lock lock{mutex_};
+		signals::detail::AllocationScope scope{this};
+		for (auto& slot : slots_) {
+			slot.key->signal.store(nullptr, std::memory_order_release);
+			retiredCallbacks_.push_back(std::move(slot.callback));
+		}
+		slots_.clear();
+		publish();
+	}
+
+	template <typename... Args>
+	void RealtimeSignal<Args...>::collect() {
+		std::scoped_lock lock{mutex_};
+		collectRetired();
+	}
+
+	template <typename... Args>
+	void RealtimeSignal<Args...>::collectRetired() {
+		const auto reading = reading_.load(std::memory_order_seq_cst);
+		bool callbacksInUse = false;
+		for (auto& list : retired_) {
+			if (list.get() == reading) {
+				callbacksInUse = true;
+			} else if (!spare_) {
+				list->callbacks.clear(); // Capacity is kept for the next publish.
+				spare_ = std::move(list);
+			} else {
+				list.reset();
+			}
+		}
+		std::erase(retired_, nullptr);
+		if (!callbacksInUse) {
+			// No retired list is read, i.e. no retired callback can be executing.
+			retiredCallbacks_.clear();
+		}
+	}
+
+	template <typename... Args>
+	int RealtimeSignal<Args...>::size() const {
+		std::scoped_lock lock{mutex_};
+		return static_cast<int>(slots_.size());
+	}
+
+	template <typename... Args>
+	bool RealtimeSignal<Args...>::empty() const {
+		std::scoped_lock lock{mutex_};
+		return slots_.empty();
+	}
+
+	template <typename... Args>
+	void RealtimeSignal<Args...>::disconnect(const signals::Connection::Key& key) {
+		std::scoped_lock lock{mutex_};
+		auto it = std::find_if(slots_.begin(), slots_.end(), [&key](const Slot& slot) {
+			return slot.key.get() == &key;
+		});
+		if (it != slots_.end()) {
+			signals::detail::AllocationScope scope{this};
+			it->key->signal.store(nullptr, std::memory_order_release);
+			retiredCallbacks_.push_back(std::move(it->callback));
+			slots_.erase(it);
+			publish();
+		}
+	}
+
+	template <typename... Args>
+	void RealtimeSignal<Args...>::publish() {
+		auto list = takeSpare();
+		list->callbacks.reserve(slots_.size());
+		for (const auto& slot : slots_) {
+			list->callbacks.push_back(slot.callback.get());
+		}
+		auto old = current_.exchange(list.release(), std::memory_order_seq_cst);
+		retired_.emplace_back(old);
+		collectRetired();
+	}
+
+	template <typename... Args>
+	std::unique_ptr<typename RealtimeSignal<Args...>::SlotList> RealtimeSignal<Args...>::takeSpare() {
+		if (spare_) {
+			return std::move(spare_);
+		}
+		return signals::detail::makeUnique<SlotList>();
+	}
+
+}
+
+#endif
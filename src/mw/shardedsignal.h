@@ -0,0 +1,254 @@
+#ifndef SIGNAL_MW_SHARDEDSIGNAL_H
+#define SIGNAL_MW_SHARDEDSIGNAL_H
+
+#include "signal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mw {
+
+	namespace signals {
+
+		/// @brief Return a small number unique to the calling thread, assigned in order of first call.
+		inline std::size_t threadIndex() noexcept {
+			static std::atomic<std::size_t> threads{0};
+			thread_local const std::size_t index = threads.fetch_add(1, std::memory_order_relaxed);
+			return index;
+		}
+
+	}
+
+	/// @brief A signal for many threads connecting, disconnecting and emitting at the same time.
+	/// The slots are split into shards, each with its own lock, and a thread connects to the shard
+	/// picked by its thread index. Connect and disconnect only lock the shard of the slot and take
+	/// constant time. Invoke locks one shard at a time to take a snapshot of the slots, and calls
+	/// them without holding any lock. The order of the slots is unspecified.
+	///
+	/// Connection::disconnect() is safe from any thread, also from a slot. A slot disconnected
+	/// before an invoke reaches it is not called, a disconnect racing with the call itself may
+	/// return before the call is done. Clear and destruction must not race with invoke or disconnect.
+	/// @tparam ...Args the slots invoke arguments
+	template <typename... Args>
+	class ShardedSignal : public signals::Connection::SignalInterface {
+	public:
+		using Callback = std::function<void(Args...)>;
+
+		/// @param shards number of shards, zero means one per hardware thread
+		explicit ShardedSignal(std::size_t shards = 0);
+		~ShardedSignal();
+
+		ShardedSignal(const ShardedSignal&) = delete;
+		ShardedSignal& operator=(const ShardedSignal&) = delete;
+
+		ShardedSignal(ShardedSignal&&) = delete;
+		ShardedSignal& operator=(ShardedSignal&&) = delete;
+
+		[[nodiscard]] signals::Connection connect(const Callback& callback);
+
+		template <typename T, typename... TArgs>
+		[[nodiscard]] signals::Connection connect(T* object, void(T::* ptr)(TArgs... args)) {
+			return connect([object, ptr](Args... args) {
+				(object->*ptr)(args...);
+			});
+		}
+
+		template <typename... Params>
+		void operator()(Params&&... params) {
+			invoke(std::forward<Params>(params)...);
+		}
+
+		template <typename... Params>
+		void invoke(Params&&... params);
+
+		void clear();
+
+		int size() const;
+
+		bool empty() const;
+
+		std::size_t shards() const noexcept {
+			return shardCount_;
+		}
+
+	private:
+		struct SlotState {
+			explicit SlotState(const Callback& callback)
+				: callback{callback} {
+			}
+
+			std::atomic<bool> connected{true};
+			const Callback callback;
+		};
+		using SlotStatePtr = std::shared_ptr<SlotState>;
+
+		struct ShardKey : signals::Connection::Key {
+			std::size_t shard = 0;
+			std::size_t index = 0; // Position in the shard, guarded by the shard mutex.
+		};
+
+		struct Slot {
+			std::shared_ptr<ShardKey> key;
+			SlotStatePtr state;
+		};
+
+		// Aligned to keep the locks of different shards on different cache lines.
+		struct alignas(64) Shard {
+			mutable std::mutex mutex;
+			signals::TrackedVector<Slot> slots;
+		};
+
+		// Restores the snapshot buffer when an invoke is done, also if a slot throws.
+		class SnapshotGuard {
+		public:
+			SnapshotGuard(signals::TrackedVector<SlotStatePtr>& snapshot) noexcept
+				: snapshot_{snapshot}
+				, start_{snapshot.size()} {
+			}
+
+			~SnapshotGuard() {
+				snapshot_.resize(start_);
+			}
+
+			SnapshotGuard(const SnapshotGuard&) = delete;
+			SnapshotGuard& operator=(const SnapshotGuard&) = delete;
+
+			std::size_t start() const noexcept {
+				return start_;
+			}
+
+		private:
+			signals::TrackedVector<SlotStatePtr>& snapshot_;
+			std::size_t start_;
+		};
+
+		void disconnect(const signals::Connection::Key& key) override;
+
+		std::unique_ptr<Shard[]> shards_;
+		std::size_t shardCount_;
+	};
+
+	// ------------ Definitions ------------
+
+	template <typename... Args>
+	ShardedSignal<Args...>::ShardedSignal(std::size_t shards)
+		: shardCount_{shards > 0 ? shards : std::max<std::size_t>(1, std::thread::hardware_concurrency())} {
+
+		signals::detail::AllocationScope scope{this};
+		signals::detail::trackAllocation(shardCount_ * sizeof(Shard));
+		shards_ = std::make_unique<Shard[]>(shardCount_);
+	}
+
+	template <typename... Args>
+	ShardedSignal<Args...>::~ShardedSignal() {
+		clear();
+	}
+
+	template <typename... Args>
+	signals::Connection ShardedSignal<Args...>::connect(const Callback& callback) {
+		signals::detail::AllocationScope scope{this};
+		auto key = signals::detail::makeShared<ShardKey>();
+		key->signal.store(this, std::memory_order_release);
+		key->shard = signals::threadIndex() % shardCount_;
+		auto state = signals::detail::makeShared<SlotState>(callback);
+
+		auto& shard = shards_[key->shard];
+		std::scoped_lock lock{shard.mutex};
+		key->index = shard.slots.size();
+		shard.slots.push_back({key, std::move(state)});
+		return signals::Connection(std::move(key));
+	}
+
+	template <typename... Args>
+	template <typename... Params>
+	void ShardedSignal<Args...>::invoke(Params&&... params) {
+		// Per thread, nested invokes append after the snapshot of the outer invoke.
+		static thread_local signals::TrackedVector<SlotStatePtr> snapshot;
+		SnapshotGuard guard{snapshot};
+		for (std::size_t i = 0; i < shardCount_; ++i) {
+			auto& shard = shards_[i];
+			std::scoped_lock lock{shard.mutex};
+			for (const auto& slot : shard.slots) {
+				snapshot.push_back(slot.state);
+			}
+		}
+		// Indexed, since a nested invoke may reallocate the buffer. The states do not move.
+		for (std::size_t i = guard.start(); i < snapshot.size(); ++i) {
+			const auto& state = *snapshot[i];
+			if (state.connected.load(std::memory_order_acquire)) {
+				state.callback(params...);
+			}
+		}
+	}
+
+	template <typename... Args>
+	void ShardedSignal<Args...>::clear() {
+		for (std::size_t i = 0; i < shardCount_; ++i) {
+			auto& shard = shards_[i];
+			signals::TrackedVector<Slot> slots;
+			{
+				std::scoped_lock lock{shard.mutex};
+				slots.swap(shard.slots);
+				for (auto& slot : slots) {
+					slot.key->signal.store(nullptr, std::memory_order_release);
+					slot.state->connected.store(false, std::memory_order_release);
+				}
+			}
+			// The callbacks are destroyed outside the lock, they may disconnect other slots.
+		}
+	}
+
+	template <typename... Args>
+	int ShardedSignal<Args...>::size() const {
+		std::size_t size = 0;
+		for (std::size_t i = 0; i < shardCount_; ++i) {
+			std::scoped_lock lock{shards_[i].mutex};
+			size += shards_[i].slots.size();
+		}
+		return static_cast<int>(size);
+	}
+
+	template <typename... Args>
+	bool ShardedSignal<Args...>::empty() const {
+		for (std::size_t i = 0; i < shardCount_; ++i) {
+			std::scoped_lock lock{shards_[i].mutex};
+			if (!shards_[i].slots.empty()) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <typename... Args>
+	void ShardedSignal<Args...>::disconnect(const signals::Connection::Key& key) {
+		// Only keys made by connect are bound to this signal.
+		const auto& shardKey = static_cast<const ShardKey&>(key);
+		auto& shard = shards_[shardKey.shard];
+		Slot removed;
+		{
+			std::scoped_lock lock{shard.mutex};
+			if (shardKey.signal.load(std::memory_order_relaxed) == nullptr) {
+				return; // Disconnected by another thread.
+			}
+			const auto index = shardKey.index;
+			removed = std::move(shard.slots[index]);
+			if (index + 1 != shard.slots.size()) {
+				shard.slots[index] = std::move(shard.slots.back());
+				shard.slots[index].key->index = index;
+			}
+			shard.slots.pop_back();
+			removed.key->signal.store(nullptr, std::memory_order_release);
+			removed.state->connected.store(false, std::memory_order_release);
+		}
+		// The callback is destroyed outside the lock, it may disconnect other slots.
+	}
+
+}
+
+#endif
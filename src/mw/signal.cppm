@@ -0,0 +1,21 @@
+module;
+
+#include "signal.h"
+
+export module mw.signal;
+
+export namespace mw {
+
+	using mw::Signal;
+	using mw::PublicSignal;
+
+	namespace signals {
+
+		using mw::signals::Connection;
+		using mw::signals::ScopedConnection;
+		using mw::signals::ScopedConnections;
+		using mw::signals::MoveOnlyFunction;
+
+	}
+
+}
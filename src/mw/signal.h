@@ -3,19 +3,161 @@
 
 #include <vector>
 #include <memory>
+#include <atomic>
 #include <functional>
+#include <span>
+#include <tuple>
+#include <bit>
+#include <utility>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
 
 namespace mw {
 
 	template <typename...>
 	class Signal;
 
+	template <typename...>
+	class ArenaSignal;
+
+	template <typename...>
+	class CompactSignal;
+
+	template <typename...>
+	class RealtimeSignal;
+
+	template <typename...>
+	class ShardedSignal;
+
 	namespace signals {
 
+		/// @brief Number and bytes of the allocations the library made for a signal.
+		struct AllocationStats {
+			size_t count = 0;
+			size_t bytes = 0;
+		};
+
+		/// @brief Called for every allocation the library makes, with the signal it is made for
+		/// or null if made outside of a signal. Allocations made by copying a std::function are
+		/// made by the std::function itself and not reported.
+		using AllocationHook = void (*)(const void* signal, size_t bytes);
+
+		namespace detail {
+
+			struct AllocationContext {
+				const void* signal;
+				AllocationStats* stats;
+			};
+
+			inline std::atomic<AllocationHook>& allocationHook() noexcept {
+				static std::atomic<AllocationHook> hook{nullptr};
+				return hook;
+			}
+
+			inline AllocationContext*& allocationContext() noexcept {
+				thread_local AllocationContext* context = nullptr;
+				return context;
+			}
+
+			inline void trackAllocation(size_t bytes) noexcept {
+				auto context = allocationContext();
+				if (context != nullptr && context->stats != nullptr) {
+					++context->stats->count;
+					context->stats->bytes += bytes;
+				}
+				if (auto hook = allocationHook().load(std::memory_order_acquire); hook != nullptr) {
+					hook(context != nullptr ? context->signal : nullptr, bytes);
+				}
+			}
+
+			// Attributes the allocations made by this thread during its lifetime to the signal,
+			// and counts them in the stats if not null.
+			class AllocationScope {
+			public:
+				AllocationScope(const void* signal, AllocationStats* stats = nullptr) noexcept
+					: context_{signal, stats}
+					, previous_{std::exchange(allocationContext(), &context_)} {
+				}
+
+				~AllocationScope() {
+					allocationContext() = previous_;
+				}
+
+				AllocationScope(const AllocationScope&) = delete;
+				AllocationScope& operator=(const AllocationScope&) = delete;
+
+			private:
+				AllocationContext context_;
+				AllocationContext* previous_;
+			};
+
+		}
+
+		/// @brief Installs the hook, null removes it. Opt-in, no hook is installed by default.
+		inline void setAllocationHook(AllocationHook hook) noexcept {
+			detail::allocationHook().store(hook, std::memory_order_release);
+		}
+
+		/// @brief Standard allocator reporting each allocation to the allocation tracking.
+		template <typename T>
+		class TrackedAllocator {
+		public:
+			using value_type = T;
+
+			TrackedAllocator() noexcept = default;
+
+			template <typename U>
+			TrackedAllocator(const TrackedAllocator<U>&) noexcept {
+			}
+
+			T* allocate(size_t n) {
+				detail::trackAllocation(n * sizeof(T));
+				return std::allocator<T>{}.allocate(n);
+			}
+
+			void deallocate(T* ptr, size_t n) noexcept {
+				std::allocator<T>{}.deallocate(ptr, n);
+			}
+
+			template <typename U>
+			friend bool operator==(const TrackedAllocator&, const TrackedAllocator<U>&) noexcept {
+				return true;
+			}
+		};
+
+		template <typename T>
+		using TrackedVector = std::vector<T, TrackedAllocator<T>>;
+
+		namespace detail {
+
+			// Like std::allocate_shared, reported to the allocation tracking.
+			template <typename T, typename... Params>
+			std::shared_ptr<T> makeShared(Params&&... params) {
+				return std::allocate_shared<T>(TrackedAllocator<T>{}, std::forward<Params>(params)...);
+			}
+
+			// Like std::make_unique, reported to the allocation tracking.
+			template <typename T, typename... Params>
+			std::unique_ptr<T> makeUnique(Params&&... params) {
+				trackAllocation(sizeof(T));
+				return std::make_unique<T>(std::forward<Params>(params)...);
+			}
+
+		}
+
 		/// @brief Used to disconnect a slot from a signal
 		class Connection {
 		public:
 			template <typename...> friend class ::mw::Signal;
+			template <typename...> friend class ::mw::ArenaSignal;
+			template <typename...> friend class ::mw::CompactSignal;
+			template <typename...> friend class ::mw::RealtimeSignal;
+			template <typename...> friend class ::mw::ShardedSignal;
 
 			Connection() noexcept = default;
 			Connection(const Connection&) = default;
@@ -29,6 +171,8 @@ namespace mw {
 			bool connected() const;
 
 		private:
+			struct Key;
+
 			class SignalInterface {
 			protected:
 				friend class Connection;
@@ -40,17 +184,18 @@ namespace mw {
 				SignalInterface(const SignalInterface&) = delete;
 				SignalInterface& operator=(const SignalInterface&) = delete;
 
-				virtual void disconnect(size_t hash) = 0;
+				virtual void disconnect(const Key& key) = 0;
 			};
 
+			// The signal is atomic, so copies of a connection may be disconnected from different
+			// threads for the signals supporting it.
 			struct Key {
-				SignalInterface* signal;
+				std::atomic<SignalInterface*> signal;
 			};
 			using KeyPtr = std::shared_ptr<Key>;
 
-			static inline size_t calculateHash(const KeyPtr& key) {
-				return std::hash<KeyPtr>{}(key);
-			}
+			// Approximate heap memory of one key, allocated together with the shared_ptr counters.
+			static constexpr size_t KeyMemoryUsage = sizeof(Key) + 2 * sizeof(long) + sizeof(void*);
 
 			// Is called from mw::Signal to bind a connection.
 			explicit Connection(KeyPtr c)
@@ -149,8 +294,379 @@ namespace mw {
 				return static_cast<int>(connections_.size());
 			}
 
+			/// @brief Allocates room for the given number of connections, adding up to it does not allocate.
+			void reserve(int size) {
+				connections_.reserve(static_cast<size_t>(size));
+			}
+
+			void shrink_to_fit() {
+				connections_.shrink_to_fit();
+			}
+
 		private:
-			std::vector<Connection> connections_;
+			TrackedVector<Connection> connections_;
+		};
+
+		template <typename Signature>
+		class MoveOnlyFunction;
+
+		/// @brief Type erased callable like std::function, but the callable is moved in, never
+		/// copied, and may be move-only. Small callables are stored inline without allocation.
+		/// @tparam R the return type
+		/// @tparam ...Args the call arguments
+		template <typename R, typename... Args>
+		class MoveOnlyFunction<R(Args...)> {
+		public:
+			static constexpr size_t InlineSize = 4 * sizeof(void*);
+
+			MoveOnlyFunction() noexcept = default;
+
+			MoveOnlyFunction(std::nullptr_t) noexcept {
+			}
+
+			template <typename F>
+				requires (!std::same_as<std::remove_cvref_t<F>, MoveOnlyFunction>
+					&& std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+			MoveOnlyFunction(F&& f) {
+				using Callable = std::decay_t<F>;
+				if constexpr (IsInline<Callable>) {
+					::new (static_cast<void*>(buffer_)) Callable(std::forward<F>(f));
+					invoke_ = &invokeInline<Callable>;
+					manage_ = &manageInline<Callable>;
+				} else {
+					detail::trackAllocation(sizeof(Callable));
+					heap() = new Callable(std::forward<F>(f));
+					invoke_ = &invokeHeap<Callable>;
+					manage_ = &manageHeap<Callable>;
+				}
+			}
+
+			MoveOnlyFunction(MoveOnlyFunction&& other) noexcept {
+				moveFrom(other);
+			}
+
+			MoveOnlyFunction& operator=(MoveOnlyFunction&& other) noexcept {
+				if (this != &other) {
+					reset();
+					moveFrom(other);
+				}
+				return *this;
+			}
+
+			MoveOnlyFunction& operator=(std::nullptr_t) noexcept {
+				reset();
+				return *this;
+			}
+
+			MoveOnlyFunction(const MoveOnlyFunction&) = delete;
+			MoveOnlyFunction& operator=(const MoveOnlyFunction&) = delete;
+
+			~MoveOnlyFunction() {
+				reset();
+			}
+
+			R operator()(Args... args) {
+				return invoke_(buffer_, std::forward<Args>(args)...);
+			}
+
+			explicit operator bool() const noexcept {
+				return invoke_ != nullptr;
+			}
+
+			/// @brief Return the stored callable. Unchecked, the caller must know it is of type F.
+			template <typename F>
+			F& get() noexcept {
+				if constexpr (IsInline<F>) {
+					return *std::launder(reinterpret_cast<F*>(buffer_));
+				} else {
+					return *static_cast<F*>(heap());
+				}
+			}
+
+		private:
+			enum class Operation {
+				Move,
+				Destroy
+			};
+
+			using Invoke = R (*)(std::byte*, Args&&...);
+			using Manage = void (*)(Operation, std::byte* self, std::byte* other) noexcept;
+
+			template <typename F>
+			static constexpr bool IsInline = sizeof(F) <= InlineSize
+				&& alignof(F) <= alignof(std::max_align_t)
+				&& std::is_nothrow_move_constructible_v<F>;
+
+			template <typename F>
+			static R invokeInline(std::byte* buffer, Args&&... args) {
+				return std::invoke(*std::launder(reinterpret_cast<F*>(buffer)), std::forward<Args>(args)...);
+			}
+
+			template <typename F>
+			static void manageInline(Operation operation, std::byte* self, std::byte* other) noexcept {
+				auto f = std::launder(reinterpret_cast<F*>(self));
+				if (operation == Operation::Move) {
+					::new (static_cast<void*>(other)) F(std::move(*f));
+				}
+				f->~F();
+			}
+
+			template <typename F>
+			static R invokeHeap(std::byte* buffer, Args&&... args) {
+				return std::invoke(*static_cast<F*>(*reinterpret_cast<void**>(buffer)), std::forward<Args>(args)...);
+			}
+
+			template <typename F>
+			static void manageHeap(Operation operation, std::byte* self, std::byte* other) noexcept {
+				auto& pointer = *reinterpret_cast<void**>(self);
+				if (operation == Operation::Move) {
+					*reinterpret_cast<void**>(other) = pointer;
+				} else {
+					delete static_cast<F*>(pointer);
+				}
+				pointer = nullptr;
+			}
+
+			void*& heap() noexcept {
+				return *reinterpret_cast<void**>(buffer_);
+			}
+
+			void moveFrom(MoveOnlyFunction& other) noexcept {
+				if (other.manage_ != nullptr) {
+					other.manage_(Operation::Move, other.buffer_, buffer_);
+				}
+				invoke_ = std::exchange(other.invoke_, nullptr);
+				manage_ = std::exchange(other.manage_, nullptr);
+			}
+
+			void reset() noexcept {
+				if (manage_ != nullptr) {
+					manage_(Operation::Destroy, buffer_, nullptr);
+				}
+				invoke_ = nullptr;
+				manage_ = nullptr;
+			}
+
+			alignas(std::max_align_t) std::byte buffer_[InlineSize];
+			Invoke invoke_ = nullptr;
+			Manage manage_ = nullptr;
+		};
+
+		/// @brief Vector-like storage made of segments doubling in size, starting at two elements.
+		/// Elements never move when growing, i.e. references stay valid during push_back and nothing
+		/// is copied. The first segment is referenced inline, the following ones from a table.
+		/// @tparam T the element type
+		template <typename T>
+		class SegmentedVector {
+		public:
+			SegmentedVector() noexcept = default;
+
+			~SegmentedVector() {
+				clear();
+				deallocate();
+			}
+
+			SegmentedVector(const SegmentedVector&) = delete;
+			SegmentedVector& operator=(const SegmentedVector&) = delete;
+
+			SegmentedVector(SegmentedVector&& other) noexcept
+				: first_{std::exchange(other.first_, nullptr)}
+				, rest_{std::exchange(other.rest_, nullptr)}
+				, size_{std::exchange(other.size_, 0)}
+				, segments_{std::exchange(other.segments_, 0)} {
+			}
+
+			SegmentedVector& operator=(SegmentedVector&& other) noexcept {
+				if (this != &other) {
+					clear();
+					deallocate();
+					first_ = std::exchange(other.first_, nullptr);
+					rest_ = std::exchange(other.rest_, nullptr);
+					size_ = std::exchange(other.size_, 0);
+					segments_ = std::exchange(other.segments_, 0);
+				}
+				return *this;
+			}
+
+			T& operator[](size_t index) noexcept {
+				if (index < FirstSegmentSize) {
+					return first_[index];
+				}
+				const auto [segment, offset] = locate(index);
+				return rest_[segment - 1][offset];
+			}
+
+			const T& operator[](size_t index) const noexcept {
+				return const_cast<SegmentedVector&>(*this)[index];
+			}
+
+			size_t size() const noexcept {
+				return size_;
+			}
+
+			bool empty() const noexcept {
+				return size_ == 0;
+			}
+
+			/// @brief Return the number of elements the allocated segments can hold.
+			size_t capacity() const noexcept {
+				return FirstSegmentSize * ((size_t{1} << segments_) - 1);
+			}
+
+			/// @brief Return the number of bytes allocated for the segments and the segment table.
+			size_t memoryUsage() const noexcept {
+				return capacity() * sizeof(T) + tableCapacity(segments_) * sizeof(T*);
+			}
+
+			/// @brief Return the first segment, null when nothing is allocated. It stays the same
+			/// while the storage is alive, also when growing, i.e. it identifies the storage.
+			const T* storage() const noexcept {
+				return first_;
+			}
+
+			template <typename... Params>
+			T& emplace_back(Params&&... params) {
+				if (size_ == capacity()) {
+					addSegment();
+				}
+				auto element = std::construct_at(&(*this)[size_], std::forward<Params>(params)...);
+				++size_;
+				return *element;
+			}
+
+			void pop_back() noexcept {
+				--size_;
+				std::destroy_at(&(*this)[size_]);
+			}
+
+			/// @brief Removes the element, the following elements are moved one step down.
+			void erase(size_t index) {
+				for (size_t i = index + 1; i < size_; ++i) {
+					(*this)[i - 1] = std::move((*this)[i]);
+				}
+				pop_back();
+			}
+
+			/// @brief Removes all elements matching the predicate, preserving the order of the rest.
+			template <typename Predicate>
+			void eraseIf(Predicate predicate) {
+				size_t alive = 0;
+				for (size_t i = 0; i < size_; ++i) {
+					if (!predicate((*this)[i])) {
+						if (alive != i) {
+							(*this)[alive] = std::move((*this)[i]);
+						}
+						++alive;
+					}
+				}
+				while (size_ > alive) {
+					pop_back();
+				}
+			}
+
+			/// @brief Allocates segments until the capacity is at least the given size.
+			void reserve(size_t size) {
+				while (capacity() < size) {
+					addSegment();
+				}
+			}
+
+			/// @brief Deallocates the segments not holding any elements.
+			void shrink_to_fit() {
+				const auto used = size_ == 0 ? 0 : locate(size_ - 1).first + 1;
+				if (used == segments_) {
+					return;
+				}
+				const auto oldCapacity = tableCapacity(segments_);
+				const auto capacity = tableCapacity(used);
+				T** table = rest_;
+				if (capacity != oldCapacity) {
+					table = capacity == 0 ? nullptr : TrackedAllocator<T*>{}.allocate(capacity);
+					std::copy_n(rest_, capacity == 0 ? 0 : used - 1, table);
+				}
+				while (segments_ > used) {
+					--segments_;
+					TrackedAllocator<T>{}.deallocate(segment(segments_), segmentSize(segments_));
+				}
+				if (table != rest_) {
+					deallocateTable(oldCapacity);
+					rest_ = table;
+				}
+				if (segments_ == 0) {
+					first_ = nullptr;
+				}
+			}
+
+			/// @brief Destroys all elements, the allocated segments are kept.
+			void clear() noexcept {
+				while (size_ > 0) {
+					pop_back();
+				}
+			}
+
+		private:
+			static constexpr size_t FirstSegmentShift = 1;
+			static constexpr size_t FirstSegmentSize = size_t{1} << FirstSegmentShift;
+
+			static size_t segmentSize(size_t segment) noexcept {
+				return FirstSegmentSize << segment;
+			}
+
+			static std::pair<size_t, size_t> locate(size_t index) noexcept {
+				const auto n = index + FirstSegmentSize;
+				const auto segment = static_cast<size_t>(std::bit_width(n)) - 1 - FirstSegmentShift;
+				return {segment, n - segmentSize(segment)};
+			}
+
+			// The table holds the segments after the first, it grows by doubling.
+			static size_t tableCapacity(size_t segments) noexcept {
+				return segments <= 1 ? 0 : std::bit_ceil(segments - 1);
+			}
+
+			T*& segment(size_t index) noexcept {
+				return index == 0 ? first_ : rest_[index - 1];
+			}
+
+			void addSegment() {
+				auto data = TrackedAllocator<T>{}.allocate(segmentSize(segments_));
+				if (const auto capacity = tableCapacity(segments_ + 1); capacity != tableCapacity(segments_)) {
+					T** table = nullptr;
+					try {
+						table = TrackedAllocator<T*>{}.allocate(capacity);
+					} catch (...) {
+						TrackedAllocator<T>{}.deallocate(data, segmentSize(segments_));
+						throw;
+					}
+					if (segments_ > 1) {
+						std::copy_n(rest_, segments_ - 1, table);
+					}
+					deallocateTable(tableCapacity(segments_));
+					rest_ = table;
+				}
+				segment(segments_) = data;
+				++segments_;
+			}
+
+			void deallocateTable(size_t capacity) noexcept {
+				if (rest_ != nullptr) {
+					TrackedAllocator<T*>{}.deallocate(rest_, capacity);
+					rest_ = nullptr;
+				}
+			}
+
+			void deallocate() noexcept {
+				for (size_t index = 0; index < segments_; ++index) {
+					TrackedAllocator<T>{}.deallocate(segment(index), segmentSize(index));
+				}
+				deallocateTable(tableCapacity(segments_));
+				first_ = nullptr;
+				segments_ = 0;
+			}
+
+			T* first_ = nullptr;
+			T** rest_ = nullptr;
+			std::uint32_t size_ = 0;
+			std::uint32_t segments_ = 0;
 		};
 
 	}
@@ -161,6 +677,8 @@ namespace mw {
 	class Signal : public signals::Connection::SignalInterface {
 	public:
 		using Callback = std::function<void(Args...)>;
+		using Event = std::tuple<Args...>;
+		using BatchCallback = std::function<void(std::span<const Event>)>;
 
 		Signal() = default;
 		~Signal();
@@ -168,17 +686,46 @@ namespace mw {
 		Signal(const Signal&) = delete;
 		Signal& operator=(const Signal&) = delete;
 
+		/// @brief A slot may move the signal or assign to it, which ends the ongoing invoke.
+		/// Slots replaced by an assignment are destroyed when the invoke is done.
 		Signal(Signal&&) noexcept;
 		Signal& operator=(Signal&&) noexcept;
 
 		[[nodiscard]] signals::Connection connect(const Callback& callback);
 
+		/// @brief Moves the callable directly into the slot storage. Move-only callables are allowed.
+		template <typename F>
+			requires (!std::same_as<std::remove_cvref_t<F>, Callback> && std::invocable<std::decay_t<F>&, Args...>)
+		[[nodiscard]] signals::Connection connect(F&& callback);
+
+		/// @brief Connects a slot receiving all events of a batch at once. A single invoke
+		/// is delivered as a batch of one event.
+		[[nodiscard]] signals::Connection connectBatch(const BatchCallback& callback);
+
 		template <typename... Params>
 		void operator()(Params&&... params);
 
 		template <typename... Params>
 		void invoke(Params&&... params);
 
+		/// @brief Invokes the slots with arguments built by the factory, only if there are any
+		/// listeners. The factory is called at most once and the result is shared by all slots.
+		/// The factory returns either the arguments as a tuple or, for a single argument, the value.
+		/// @return true if the factory was called
+		template <typename Factory>
+			requires std::invocable<Factory&>
+		bool invokeWith(Factory&& factory);
+
+		/// @brief Return true if an invoke would reach any slot, directly or through forwards.
+		/// Forwards to signals without slots, or only forwarding to such, do not count.
+		bool hasListeners() const noexcept {
+			return size_ != 0 || (forwardSize() != 0 && forwardHasListeners());
+		}
+
+		/// @brief Invokes all slots for every event, slot by slot. I.e. the first slot gets
+		/// all events before the next slot gets any. Batch slots get the whole span in one call.
+		void invokeBatch(std::span<const Event> events);
+
 		template <typename T, typename... TArgs>
 		[[nodiscard]] signals::Connection connect(T* object, void(T::* ptr)(TArgs... args)) {
 			return connect([object, ptr](Args... args) {
@@ -186,23 +733,176 @@ namespace mw {
 			});
 		}
 
+		/// @brief Forwards all invokes to the target signal, after this signal's own slots.
+		/// The arguments are passed on without copies or type erased calls, and chains of single
+		/// forwards are walked in a loop. The forward is disconnected when either signal is
+		/// destroyed.
+		/// @throws std::invalid_argument if the target is this signal or forwards back to it
+		[[nodiscard]] signals::Connection forwardTo(Signal& target);
+
 		void clear();
 
+		/// @brief Return the number of connections, forwards included.
 		int size() const noexcept;
 
 		bool empty() const noexcept;
 
+		/// @brief Return the approximate number of bytes used by the signal, the slot storage and
+		/// the connection keys. Memory allocated by the callbacks themselves is not included.
+		size_t memoryUsage() const noexcept;
+
+#ifdef MW_SIGNAL_ALLOCATION_STATS
+		/// @brief Return the allocations the signal has made, for keys, slot storage and callables
+		/// too large to be stored inline. Invoke never allocates. Only counted when
+		/// MW_SIGNAL_ALLOCATION_STATS is defined, to keep the signal small otherwise.
+		const signals::AllocationStats& allocationStats() const noexcept {
+			static constexpr signals::AllocationStats None{};
+			return extra_ ? extra_->allocationStats : None;
+		}
+#endif
+
+		/// @brief Allocates slot storage for the given number of slots. Connecting then only
+		/// allocates the connection key, and the callable if it is too large to be stored inline.
+		void reserve(int size);
+
+		/// @brief Deallocates the slot storage not in use.
+		void shrink_to_fit();
+
 	private:
 		using KeyPtr = signals::Connection::KeyPtr;
 
-		void disconnect(size_t hash) override;
+		void disconnect(const signals::Connection::Key& key) override;
+
+		void removeDisconnected();
+
+		// Return false if a slot moved the signal or assigned to it, which ends the invoke.
+		template <typename... Params>
+		bool invokeSlots(Params&... params);
+
+		// Kept out of invoke, which then stays small enough to be inlined.
+		template <typename... Params>
+		void invokeForwards(Params&... params);
+
+		// Reference arguments are passed as the referenced objects, values as const lvalues.
+		template <size_t... I>
+		static void invokeEvent(signals::MoveOnlyFunction<void(Args...)>& callback, const Event& event, std::index_sequence<I...>) {
+			callback(std::get<I>(event)...);
+		}
+
+		void removeForward(size_t index);
+
+		// Return true if any forward target has listeners.
+		bool forwardHasListeners() const noexcept;
+
+		// Return true if an invoke of this signal reaches the signal through forwards.
+		bool forwardsTo(const Signal& signal) const;
+
+		// Disconnects forwards from other signals to this one.
+		void disconnectIncoming();
+
+		// Points forwards from other signals to this one after a move.
+		void retargetIncoming();
+
+		// Slot connected by connectBatch, a single invoke is delivered as a batch of one event.
+		struct BatchSlot {
+			void operator()(Args... args) {
+				const Event event{std::forward<Args>(args)...};
+				callback(std::span<const Event>{&event, 1});
+			}
+
+			BatchCallback callback;
+		};
 
 		struct KeyCallback {
+			template <typename F>
+			KeyCallback(KeyPtr key, F&& callback)
+				: key{std::move(key)}
+				, callback{std::forward<F>(callback)}
+				, batch{std::same_as<std::decay_t<F>, BatchSlot>} {
+			}
+
+			KeyPtr key; // Null when disconnected during invoke, removed afterwards.
+			signals::MoveOnlyFunction<void(Args...)> callback;
+			bool batch; // The callback is a BatchSlot.
+		};
+
+		// Keeps track of nested invokes and removes disconnected slots when the outermost is done.
+		class InvokeGuard {
+		public:
+			explicit InvokeGuard(Signal& signal) noexcept
+				: signal_{signal} {
+				++signal_.invoking_;
+			}
+
+			~InvokeGuard() {
+				// Checked here to keep the common case, nothing disconnected, free of calls.
+				if (--signal_.invoking_ == 0 && (signal_.size_ != signal_.callbacks_.size() || signal_.extra_)) {
+					signal_.removeDisconnected();
+				}
+			}
+
+			InvokeGuard(const InvokeGuard&) = delete;
+			InvokeGuard& operator=(const InvokeGuard&) = delete;
+
+		private:
+			Signal& signal_;
+		};
+
+		struct Forward {
 			KeyPtr key;
-			Callback callback;
+			Signal* target; // Null when disconnected during invoke, removed afterwards.
+		};
+
+		struct Extra;
+
+		// State replaced by a move assignment during invoke, one of its slots may be executing.
+		struct Retired {
+			signals::SegmentedVector<KeyCallback> callbacks;
+			std::unique_ptr<Extra> extra;
+		};
+
+		// Rarely used state, allocated on first use.
+		struct Extra {
+			// Return true if nothing is left that needs to be kept.
+			bool unused() const noexcept {
+#ifdef MW_SIGNAL_ALLOCATION_STATS
+				return false; // The stats are kept for the lifetime of the signal.
+#else
+				return forwards.empty() && incoming.empty() && retired.empty();
+#endif
+			}
+
+			signals::TrackedVector<Forward> forwards;
+			size_t forwardSize = 0;
+			signals::TrackedVector<KeyPtr> incoming; // Keys of the forwards from other signals to this one.
+			signals::TrackedVector<Retired> retired; // Destroyed when the outermost invoke is done.
+#ifdef MW_SIGNAL_ALLOCATION_STATS
+			signals::AllocationStats allocationStats;
+#endif
 		};
 
-		std::vector<KeyCallback> callbacks_;
+		KeyPtr makeKey();
+
+		// Attributes the allocations made until the returned scope ends to this signal.
+		signals::detail::AllocationScope trackAllocations() {
+#ifdef MW_SIGNAL_ALLOCATION_STATS
+			return {this, &extra().allocationStats};
+#else
+			return {this};
+#endif
+		}
+
+		Extra& extra();
+
+		size_t forwardSize() const noexcept {
+			return extra_ ? extra_->forwardSize : 0;
+		}
+
+		// Segmented, so a slot connecting new slots never moves the executing callback.
+		signals::SegmentedVector<KeyCallback> callbacks_;
+		std::uint32_t size_ = 0;
+		int invoking_ = 0;
+		std::unique_ptr<Extra> extra_; // Null until the signal forwards or is forwarded to.
 	};
 
 	
@@ -214,6 +914,8 @@ namespace mw {
 	class PublicSignal {
 	public:
 		using Callback = typename Signal<Args...>::Callback;
+		using Event = typename Signal<Args...>::Event;
+		using BatchCallback = typename Signal<Args...>::BatchCallback;
 
 		friend Friend;
 
@@ -222,11 +924,37 @@ namespace mw {
 			return signal_.connect(callback);
 		}
 
+		template <typename F>
+			requires (!std::same_as<std::remove_cvref_t<F>, Callback> && std::invocable<std::decay_t<F>&, Args...>)
+		[[nodiscard]] signals::Connection connect(F&& callback) {
+			return signal_.connect(std::forward<F>(callback));
+		}
+
+		[[nodiscard]]
+		signals::Connection connectBatch(const BatchCallback& callback) {
+			return signal_.connectBatch(callback);
+		}
+
 		template <typename T, typename... TArgs>
 		[[nodiscard]] signals::Connection connect(T* object, void(T::* ptr)(TArgs... args)) {
 			return signal_.connect(object, ptr);
 		}
 
+		[[nodiscard]]
+		signals::Connection forwardTo(Signal<Args...>& target) {
+			return signal_.forwardTo(target);
+		}
+
+		size_t memoryUsage() const noexcept {
+			return signal_.memoryUsage();
+		}
+
+#ifdef MW_SIGNAL_ALLOCATION_STATS
+		const signals::AllocationStats& allocationStats() const noexcept {
+			return signal_.allocationStats();
+		}
+#endif
+
 	private:
 		PublicSignal() = default;
 		PublicSignal(const PublicSignal&) = delete;
@@ -244,10 +972,32 @@ namespace mw {
 			signal_.invoke(std::forward<Params>(params)...);
 		}
 
+		void invokeBatch(std::span<const Event> events) {
+			signal_.invokeBatch(events);
+		}
+
+		template <typename Factory>
+			requires std::invocable<Factory&>
+		bool invokeWith(Factory&& factory) {
+			return signal_.invokeWith(std::forward<Factory>(factory));
+		}
+
+		bool hasListeners() const noexcept {
+			return signal_.hasListeners();
+		}
+
 		void clear() {
 			signal_.clear();
 		}
 
+		void reserve(int size) {
+			signal_.reserve(size);
+		}
+
+		void shrink_to_fit() {
+			signal_.shrink_to_fit();
+		}
+
 		int size() const noexcept {
 			return signal_.size();
 		}
@@ -262,42 +1012,69 @@ namespace mw {
 	// ------------ Definitions ------------
 
 	inline void signals::Connection::disconnect() {
-		if (key_ && key_->signal != nullptr) {
-			key_->signal->disconnect(Connection::calculateHash(key_));
+		if (key_) {
+			if (auto signal = key_->signal.load(std::memory_order_acquire); signal != nullptr) {
+				signal->disconnect(*key_);
+			}
 		}
 	}
 
 	inline bool signals::Connection::connected() const {
-		return key_ && key_->signal != nullptr;
+		return key_ && key_->signal.load(std::memory_order_acquire) != nullptr;
 	}
 
 	template <typename... Args>
 	Signal<Args...>::Signal::~Signal() {
 		clear();
+		disconnectIncoming();
 	}
 
 	template <typename... Args>
 	Signal<Args...>::Signal(Signal<Args...>&& signal) noexcept
-		: callbacks_{std::move(signal.callbacks_)} {
+		: callbacks_{std::move(signal.callbacks_)}
+		, size_{std::exchange(signal.size_, 0)}
+		, extra_{std::move(signal.extra_)} {
 		
-		for (auto& keyCallback : callbacks_) {
-			if (keyCallback.key) {
-				keyCallback.key->signal = this;
+		for (size_t i = 0; i < callbacks_.size(); ++i) {
+			if (callbacks_[i].key) {
+				callbacks_[i].key->signal.store(this, std::memory_order_release);
+			}
+		}
+		if (extra_) {
+			for (auto& forward : extra_->forwards) {
+				forward.key->signal.store(this, std::memory_order_release);
 			}
 		}
+		retargetIncoming();
 		signal.clear();
 	}
 
 	template <typename... Args>
 	Signal<Args...>& Signal<Args...>::operator=(Signal<Args...>&& signal) noexcept {
 		if (this != &signal) {
+			clear();
+			disconnectIncoming();
+			Retired retired{std::move(callbacks_), std::move(extra_)};
 			callbacks_ = std::move(signal.callbacks_);
+			size_ = std::exchange(signal.size_, 0);
+			extra_ = std::move(signal.extra_);
+			if (invoking_ > 0) {
+				// The replaced slots may be executing, they are destroyed when the invoke is done.
+				auto scope = trackAllocations();
+				extra().retired.push_back(std::move(retired));
+			}
 			
-			for (auto& keyCallback : callbacks_) {
-				if (keyCallback.key) {
-					keyCallback.key->signal = this;
+			for (size_t i = 0; i < callbacks_.size(); ++i) {
+				if (callbacks_[i].key) {
+					callbacks_[i].key->signal.store(this, std::memory_order_release);
+				}
+			}
+			if (extra_) {
+				for (auto& forward : extra_->forwards) {
+					forward.key->signal.store(this, std::memory_order_release);
 				}
 			}
+			retargetIncoming();
 			signal.clear();
 		}
 		return *this;
@@ -305,8 +1082,30 @@ namespace mw {
 
 	template <typename... Args>
 	signals::Connection Signal<Args...>::connect(const Callback& callback) {
-		auto c = std::make_shared<signals::Connection::Key>(this);
-		callbacks_.push_back({c, callback});
+		auto scope = trackAllocations();
+		auto c = makeKey();
+		callbacks_.emplace_back(c, callback);
+		++size_;
+		return signals::Connection(c);
+	}
+
+	template <typename... Args>
+	template <typename F>
+		requires (!std::same_as<std::remove_cvref_t<F>, typename Signal<Args...>::Callback> && std::invocable<std::decay_t<F>&, Args...>)
+	signals::Connection Signal<Args...>::connect(F&& callback) {
+		auto scope = trackAllocations();
+		auto c = makeKey();
+		callbacks_.emplace_back(c, std::forward<F>(callback));
+		++size_;
+		return signals::Connection(c);
+	}
+
+	template <typename... Args>
+	signals::Connection Signal<Args...>::connectBatch(const BatchCallback& callback) {
+		auto scope = trackAllocations();
+		auto c = makeKey();
+		callbacks_.emplace_back(c, BatchSlot{callback});
+		++size_;
 		return signals::Connection(c);
 	}
 
@@ -319,45 +1118,360 @@ namespace mw {
 	template <typename... Args>
 	template <typename... Params>
 	void Signal<Args...>::invoke(Params&&... a) {
-		const auto size = static_cast<int>(callbacks_.size());
-		// Using index instead of foreach in order to be able to add callbacks during iteration.
-		for (int i = 0; i < size && i < callbacks_.size(); ++i) {
-			callbacks_[i].callback(a...);
+		if (!hasListeners()) {
+			return;
+		}
+		InvokeGuard guard{*this};
+		if (invokeSlots(a...) && extra_ && !extra_->forwards.empty()) {
+			invokeForwards(a...);
+		}
+	}
+
+	template <typename... Args>
+	template <typename... Params>
+	void Signal<Args...>::invokeForwards(Params&... a) {
+		// Forwards added during iteration are placed after size and are not invoked.
+		auto& forwards = extra_->forwards;
+		const auto size = forwards.size();
+		if (size != 1) {
+			for (size_t i = 0; i < size; ++i) {
+				if (auto target = forwards[i].target; target != nullptr) {
+					target->invoke(a...);
+				}
+			}
+			return;
+		}
+		// Continue chains of single forwards in this loop instead of recursing.
+		Signal* signal = forwards.front().target;
+		while (signal != nullptr) {
+			InvokeGuard guard{*signal};
+			if (!signal->invokeSlots(a...) || !signal->extra_ || signal->extra_->forwards.empty()) {
+				return;
+			}
+			if (signal->extra_->forwards.size() != 1) {
+				signal->invokeForwards(a...);
+				return;
+			}
+			signal = signal->extra_->forwards.front().target;
+		}
+	}
+
+	template <typename... Args>
+	template <typename Factory>
+		requires std::invocable<Factory&>
+	bool Signal<Args...>::invokeWith(Factory&& factory) {
+		if (!hasListeners()) {
+			return false;
+		}
+		decltype(auto) payload = std::invoke(factory);
+		if constexpr (std::invocable<Callback&, decltype(payload)&>) {
+			invoke(payload);
+		} else {
+			std::apply([this](auto&... params) {
+				invoke(params...);
+			}, payload);
 		}
+		return true;
+	}
+
+	template <typename... Args>
+	template <typename... Params>
+	bool Signal<Args...>::invokeSlots(Params&... a) {
+		// Callbacks added during iteration are placed after size and are not invoked.
+		const auto size = callbacks_.size();
+		const auto storage = callbacks_.storage();
+		for (size_t i = 0; i < size && i < callbacks_.size(); ++i) {
+			auto& keyCallback = callbacks_[i];
+			if (keyCallback.key) {
+				keyCallback.callback(a...);
+				if (callbacks_.storage() != storage) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	template <typename... Args>
+	void Signal<Args...>::invokeBatch(std::span<const Event> events) {
+		InvokeGuard guard{*this};
+		const auto size = callbacks_.size();
+		const auto storage = callbacks_.storage();
+		for (size_t i = 0; i < size && i < callbacks_.size(); ++i) {
+			auto& keyCallback = callbacks_[i];
+			if (!keyCallback.key) {
+				continue;
+			}
+			if (keyCallback.batch) {
+				keyCallback.callback.template get<BatchSlot>().callback(events);
+			} else {
+				for (const auto& event : events) {
+					if (!keyCallback.key || callbacks_.storage() != storage) {
+						break; // Disconnected, moved or replaced by itself or a previous event.
+					}
+					invokeEvent(keyCallback.callback, event, std::index_sequence_for<Args...>{});
+				}
+			}
+			if (callbacks_.storage() != storage) {
+				return; // The signal was moved or assigned to by the slot.
+			}
+		}
+		if (!extra_) {
+			return;
+		}
+		auto& forwards = extra_->forwards;
+		const auto forwardsSize = forwards.size();
+		for (size_t i = 0; i < forwardsSize; ++i) {
+			if (auto target = forwards[i].target; target != nullptr) {
+				target->invokeBatch(events);
+			}
+		}
+	}
+
+	template <typename... Args>
+	signals::Connection Signal<Args...>::forwardTo(Signal& target) {
+		if (&target == this || target.forwardsTo(*this)) {
+			throw std::invalid_argument("Forwarding would form a cycle");
+		}
+		auto scope = trackAllocations();
+		auto c = makeKey();
+		extra().forwards.push_back({c, &target});
+		{
+			auto targetScope = target.trackAllocations();
+			target.extra().incoming.push_back(c);
+		}
+		++extra_->forwardSize;
+		return signals::Connection(c);
 	}
 
 	template <typename... Args>
 	void Signal<Args...>::clear() {
-		for (auto& [key, callback] : callbacks_) {
-			key->signal = nullptr;
+		for (size_t i = 0; i < callbacks_.size(); ++i) {
+			auto& keyCallback = callbacks_[i];
+			if (keyCallback.key) {
+				keyCallback.key->signal.store(nullptr, std::memory_order_release);
+				keyCallback.key = nullptr;
+			}
+		}
+		size_ = 0;
+		if (invoking_ == 0) {
+			callbacks_.clear();
+		}
+		if (extra_) {
+			for (size_t i = extra_->forwards.size(); i > 0; --i) {
+				if (extra_->forwards[i - 1].target != nullptr) {
+					removeForward(i - 1);
+				}
+			}
 		}
-		callbacks_.clear();
+	}
+
+	template <typename... Args>
+	void Signal<Args...>::reserve(int size) {
+		auto scope = trackAllocations();
+		callbacks_.reserve(static_cast<size_t>(size));
+	}
+
+	template <typename... Args>
+	void Signal<Args...>::shrink_to_fit() {
+		auto scope = trackAllocations();
+		if (invoking_ == 0) {
+			callbacks_.shrink_to_fit();
+		}
+		if (!extra_) {
+			return;
+		}
+		if (invoking_ == 0 && extra_->unused()) {
+			extra_ = nullptr;
+			return;
+		}
+		if (invoking_ == 0) {
+			extra_->forwards.shrink_to_fit();
+		}
+		extra_->incoming.shrink_to_fit();
 	}
 
 	template <typename... Args>
 	int Signal<Args...>::size() const noexcept {
-		return static_cast<int>(callbacks_.size());
+		return static_cast<int>(size_ + forwardSize());
 	}
 
 	template <typename... Args>
 	bool Signal<Args...>::empty() const noexcept {
-		return callbacks_.empty();
+		return size_ == 0 && forwardSize() == 0;
+	}
+
+	template <typename... Args>
+	size_t Signal<Args...>::memoryUsage() const noexcept {
+		auto usage = sizeof(Signal)
+			+ callbacks_.memoryUsage()
+			+ size_ * signals::Connection::KeyMemoryUsage;
+		if (extra_) {
+			usage += sizeof(Extra)
+				+ extra_->forwards.capacity() * sizeof(Forward)
+				+ extra_->incoming.capacity() * sizeof(KeyPtr)
+				+ extra_->forwardSize * signals::Connection::KeyMemoryUsage;
+		}
+		return usage;
 	}
 
 	template <typename... Args>
-	void Signal<Args...>::disconnect(size_t hash) {
-		auto it = std::find_if(callbacks_.begin(), callbacks_.end(), [hash](const KeyCallback& keyCallback) {
-			if (signals::Connection::calculateHash(keyCallback.key) == hash) {
+	void Signal<Args...>::disconnect(const signals::Connection::Key& key) {
+		for (size_t i = 0; i < callbacks_.size(); ++i) {
+			auto& keyCallback = callbacks_[i];
+			if (keyCallback.key.get() == &key) {
+				keyCallback.key->signal.store(nullptr, std::memory_order_release);
+				--size_;
+				if (invoking_ > 0) {
+					// The callback may be executing, it is removed when the invoke is done.
+					keyCallback.key = nullptr;
+				} else {
+					callbacks_.erase(i);
+				}
+				return;
+			}
+		}
+		if (!extra_) {
+			return;
+		}
+		for (size_t i = 0; i < extra_->forwards.size(); ++i) {
+			if (extra_->forwards[i].target != nullptr && extra_->forwards[i].key.get() == &key) {
+				removeForward(i);
+				return;
+			}
+		}
+	}
+
+	template <typename... Args>
+	void Signal<Args...>::removeDisconnected() {
+		if (size_ != callbacks_.size()) {
+			callbacks_.eraseIf([](const KeyCallback& keyCallback) {
+				return !keyCallback.key;
+			});
+		}
+		if (!extra_) {
+			return;
+		}
+		extra_->retired.clear();
+		if (extra_->forwardSize != extra_->forwards.size()) {
+			std::erase_if(extra_->forwards, [](const Forward& forward) {
+				return forward.target == nullptr;
+			});
+		}
+	}
+
+	template <typename... Args>
+	typename Signal<Args...>::KeyPtr Signal<Args...>::makeKey() {
+		return signals::detail::makeShared<signals::Connection::Key>(this);
+	}
+
+	template <typename... Args>
+	typename Signal<Args...>::Extra& Signal<Args...>::extra() {
+		if (!extra_) {
+			// Counted in the stats it holds.
+			signals::AllocationStats stats;
+			signals::detail::AllocationScope scope{this, &stats};
+			extra_ = signals::detail::makeUnique<Extra>();
+#ifdef MW_SIGNAL_ALLOCATION_STATS
+			extra_->allocationStats = stats;
+#endif
+		}
+		return *extra_;
+	}
+
+	template <typename... Args>
+	bool Signal<Args...>::forwardHasListeners() const noexcept {
+		auto hasTarget = [](const Forward& forward) {
+			return forward.target != nullptr;
+		};
+		// Follow chains of single forwards in this loop instead of recursing.
+		const Signal* signal = this;
+		while (signal->forwardSize() == 1) {
+			const auto& forwards = signal->extra_->forwards;
+			signal = std::find_if(forwards.begin(), forwards.end(), hasTarget)->target;
+			if (signal->size_ != 0) {
 				return true;
 			}
+		}
+		if (signal->forwardSize() == 0) {
 			return false;
+		}
+		const auto& forwards = signal->extra_->forwards;
+		return std::any_of(forwards.begin(), forwards.end(), [&](const Forward& forward) {
+			return hasTarget(forward) && forward.target->hasListeners();
 		});
-		if (it != callbacks_.end()) {
-			it->key->signal = nullptr;
-			callbacks_.erase(it);
+	}
+
+	template <typename... Args>
+	bool Signal<Args...>::forwardsTo(const Signal& signal) const {
+		// Existing forwards form no cycle, so the walk ends without marking visited signals.
+		signals::TrackedVector<const Signal*> pending{this};
+		while (!pending.empty()) {
+			auto current = pending.back();
+			pending.pop_back();
+			if (current->forwardSize() == 0) {
+				continue;
+			}
+			for (const auto& forward : current->extra_->forwards) {
+				if (forward.target == &signal) {
+					return true;
+				}
+				if (forward.target != nullptr) {
+					pending.push_back(forward.target);
+				}
+			}
+		}
+		return false;
+	}
+
+	template <typename... Args>
+	void Signal<Args...>::removeForward(size_t index) {
+		auto& forward = extra_->forwards[index];
+		forward.key->signal.store(nullptr, std::memory_order_release);
+		std::erase(forward.target->extra_->incoming, forward.key);
+		--extra_->forwardSize;
+		if (invoking_ > 0) {
+			forward.target = nullptr;
+		} else {
+			extra_->forwards.erase(extra_->forwards.begin() + index);
+		}
+	}
+
+	template <typename... Args>
+	void Signal<Args...>::disconnectIncoming() {
+		if (!extra_) {
+			return;
+		}
+		auto incoming = std::move(extra_->incoming);
+		extra_->incoming.clear();
+		for (auto& key : incoming) {
+			if (auto signal = key->signal.load(std::memory_order_relaxed); signal != nullptr) {
+				// Forwards are only made between signals of the same type.
+				auto source = static_cast<Signal*>(signal);
+				source->disconnect(*key);
+			}
+		}
+	}
+
+	template <typename... Args>
+	void Signal<Args...>::retargetIncoming() {
+		if (!extra_) {
+			return;
+		}
+		for (auto& key : extra_->incoming) {
+			auto source = static_cast<Signal*>(key->signal.load(std::memory_order_relaxed));
+			for (auto& forward : source->extra_->forwards) {
+				if (forward.key == key) {
+					forward.target = this;
+				}
+			}
 		}
 	}
 
 }
 
+#ifdef MW_SIGNAL_EXTERN_TEMPLATES
+#include "signalinstances.h"
+#endif
+
 #endif
@@ -0,0 +1,28 @@
+#ifndef SIGNAL_MW_SIGNALINSTANCES_H
+#define SIGNAL_MW_SIGNALINSTANCES_H
+
+#include "signal.h"
+
+#include <string>
+
+/// @brief The signatures compiled into the Signal_Instances library, each given as the
+/// template arguments to Signal. With MW_SIGNAL_EXTERN_TEMPLATES defined, which linking to
+/// Signal::Instances does, they are declared extern and not instantiated in every translation unit.
+/// PublicSignal only forwards to Signal and is covered by the same instances.
+#define MW_SIGNAL_INSTANCES(X) \
+	X() \
+	X(bool) \
+	X(int) \
+	X(float) \
+	X(double) \
+	X(const std::string&)
+
+#ifdef MW_SIGNAL_EXTERN_TEMPLATES
+
+#define MW_SIGNAL_EXTERN_TEMPLATE(...) extern template class mw::Signal<__VA_ARGS__>;
+MW_SIGNAL_INSTANCES(MW_SIGNAL_EXTERN_TEMPLATE)
+#undef MW_SIGNAL_EXTERN_TEMPLATE
+
+#endif
+
+#endif
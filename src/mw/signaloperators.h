@@ -0,0 +1,230 @@
+#ifndef SIGNAL_MW_SIGNALOPERATORS_H
+#define SIGNAL_MW_SIGNALOPERATORS_H
+
+#include "signal.h"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace mw::signals {
+
+	template <typename...>
+	struct TypeList {};
+
+	namespace detail {
+
+		template <typename Tuple>
+		struct TupleToTypeList;
+
+		template <typename... Ts>
+		struct TupleToTypeList<std::tuple<Ts...>> {
+			using Type = TypeList<Ts...>;
+		};
+
+	}
+
+	/// @brief Base class for the pipeline operators. An operator declares its output types given
+	/// its input types and binds itself to the next callable in the pipeline.
+	struct PipelineStage {};
+
+	template <typename T>
+	concept PipelineStageType = std::derived_from<std::remove_cvref_t<T>, PipelineStage>;
+
+	/// @brief Passes on the arguments only when the predicate returns true.
+	template <typename Predicate>
+	class Filter : public PipelineStage {
+	public:
+		explicit Filter(Predicate predicate)
+			: predicate_{std::move(predicate)} {
+		}
+
+		template <typename... In>
+		using Output = TypeList<In...>;
+
+		template <typename... In, typename Next>
+		auto bind(Next next) const {
+			return [predicate = predicate_, next = std::move(next)](In... in) mutable {
+				if (std::invoke(predicate, std::as_const(in)...)) {
+					next(std::forward<In>(in)...);
+				}
+			};
+		}
+
+	private:
+		Predicate predicate_;
+	};
+
+	/// @brief Replaces the arguments with the result of the function.
+	template <typename Function>
+	class Map : public PipelineStage {
+	public:
+		explicit Map(Function function)
+			: function_{std::move(function)} {
+		}
+
+		template <typename... In>
+		using Output = TypeList<std::invoke_result_t<Function&, In...>>;
+
+		template <typename... In, typename Next>
+		auto bind(Next next) const {
+			static_assert(!std::is_void_v<std::invoke_result_t<Function&, In...>>, "map must return a value");
+			return [function = function_, next = std::move(next)](In... in) mutable {
+				next(std::invoke(function, std::forward<In>(in)...));
+			};
+		}
+
+	private:
+		Function function_;
+	};
+
+	/// @brief Passes on the arguments only when they differ from the previous ones passed on.
+	class DistinctUntilChanged : public PipelineStage {
+	public:
+		template <typename... In>
+		using Output = TypeList<In...>;
+
+		template <typename... In, typename Next>
+		auto bind(Next next) const {
+			using Values = std::tuple<std::remove_cvref_t<In>...>;
+			return [last = std::optional<Values>{}, next = std::move(next)](In... in) mutable {
+				if (last && *last == std::forward_as_tuple(std::as_const(in)...)) {
+					return;
+				}
+				last.emplace(std::as_const(in)...);
+				next(std::forward<In>(in)...);
+			};
+		}
+	};
+
+	/// @brief Passes on the first count invokes, the following are ignored.
+	class Take : public PipelineStage {
+	public:
+		explicit Take(int count)
+			: count_{count} {
+		}
+
+		template <typename... In>
+		using Output = TypeList<In...>;
+
+		template <typename... In, typename Next>
+		auto bind(Next next) const {
+			return [remaining = count_, next = std::move(next)](In... in) mutable {
+				if (remaining > 0) {
+					--remaining;
+					next(std::forward<In>(in)...);
+				}
+			};
+		}
+
+	private:
+		int count_;
+	};
+
+	/// @brief Passes on the accumulated value, accumulator(previous value, arguments...).
+	template <typename T, typename Accumulator>
+	class Scan : public PipelineStage {
+	public:
+		Scan(T initial, Accumulator accumulator)
+			: initial_{std::move(initial)}
+			, accumulator_{std::move(accumulator)} {
+		}
+
+		template <typename... In>
+		using Output = TypeList<const T&>;
+
+		template <typename... In, typename Next>
+		auto bind(Next next) const {
+			return [value = initial_, accumulator = accumulator_, next = std::move(next)](In... in) mutable {
+				value = std::invoke(accumulator, std::move(value), std::forward<In>(in)...);
+				next(std::as_const(value));
+			};
+		}
+
+	private:
+		T initial_;
+		Accumulator accumulator_;
+	};
+
+	template <typename Predicate>
+	Filter<std::decay_t<Predicate>> filter(Predicate&& predicate) {
+		return Filter<std::decay_t<Predicate>>{std::forward<Predicate>(predicate)};
+	}
+
+	template <typename Function>
+	Map<std::decay_t<Function>> map(Function&& function) {
+		return Map<std::decay_t<Function>>{std::forward<Function>(function)};
+	}
+
+	inline DistinctUntilChanged distinctUntilChanged() {
+		return {};
+	}
+
+	inline Take take(int count) {
+		return Take{count};
+	}
+
+	template <typename T, typename Accumulator>
+	Scan<T, std::decay_t<Accumulator>> scan(T initial, Accumulator&& accumulator) {
+		return {std::move(initial), std::forward<Accumulator>(accumulator)};
+	}
+
+	/// @brief A chain of operators on a signal, connectable like the signal itself. All operators
+	/// and the slot are fused into one callable at connect time, which is connected to the source.
+	/// Each connection gets its own copy of the operator state. The source must outlive the pipeline.
+	/// @tparam Source Signal or PublicSignal
+	/// @tparam ...Stages the operators, applied in order
+	template <typename Source, typename... Stages>
+	class Pipeline {
+	public:
+		using Input = typename detail::TupleToTypeList<typename Source::Event>::Type;
+
+		Pipeline(Source& source, std::tuple<Stages...> stages)
+			: source_{&source}
+			, stages_{std::move(stages)} {
+		}
+
+		template <typename Callback>
+		[[nodiscard]] Connection connect(Callback&& callback) const {
+			return source_->connect(fuse<0>(std::forward<Callback>(callback), Input{}));
+		}
+
+		template <PipelineStageType Stage>
+		friend Pipeline<Source, Stages..., std::remove_cvref_t<Stage>> operator|(Pipeline pipeline, Stage&& stage) {
+			return {*pipeline.source_, std::tuple_cat(std::move(pipeline.stages_), std::tuple{std::forward<Stage>(stage)})};
+		}
+
+	private:
+		template <std::size_t I, typename Callback, typename... In>
+		auto fuse(Callback&& callback, TypeList<In...>) const {
+			if constexpr (I == sizeof...(Stages)) {
+				return std::decay_t<Callback>{std::forward<Callback>(callback)};
+			} else {
+				const auto& stage = std::get<I>(stages_);
+				using Stage = std::remove_cvref_t<decltype(stage)>;
+				using Output = typename Stage::template Output<In...>;
+				return stage.template bind<In...>(fuse<I + 1>(std::forward<Callback>(callback), Output{}));
+			}
+		}
+
+		Source* source_;
+		std::tuple<Stages...> stages_;
+	};
+
+	template <PipelineStageType Stage, typename... Args>
+	Pipeline<Signal<Args...>, std::remove_cvref_t<Stage>> operator|(Signal<Args...>& signal, Stage&& stage) {
+		return {signal, std::tuple{std::forward<Stage>(stage)}};
+	}
+
+	template <PipelineStageType Stage, typename Friend, typename... Args>
+	Pipeline<PublicSignal<Friend, Args...>, std::remove_cvref_t<Stage>> operator|(PublicSignal<Friend, Args...>& signal, Stage&& stage) {
+		return {signal, std::tuple{std::forward<Stage>(stage)}};
+	}
+
+}
+
+#endif
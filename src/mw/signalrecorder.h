@@ -0,0 +1,532 @@
+#ifndef SIGNAL_MW_SIGNALRECORDER_H
+#define SIGNAL_MW_SIGNALRECORDER_H
+
+#include "signal.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mw {
+
+	namespace signals {
+
+		/// @brief A file mapped into memory, either growable and writable or read only.
+		class MappedFile {
+		public:
+			enum class Mode {
+				Read,
+				Write
+			};
+
+			MappedFile() noexcept = default;
+
+			MappedFile(const std::filesystem::path& path, Mode mode, std::size_t capacity = 0);
+
+			~MappedFile() {
+				close();
+			}
+
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			/// @brief Remaps the file with a new size. Previous pointers into the mapping are invalidated.
+			void resize(std::size_t capacity);
+
+			/// @brief Unmaps the file and truncates it to the given size, if writable.
+			void close(std::size_t size);
+
+			void close() {
+				close(capacity_);
+			}
+
+			std::byte* data() noexcept {
+				return data_;
+			}
+
+			const std::byte* data() const noexcept {
+				return data_;
+			}
+
+			std::size_t capacity() const noexcept {
+				return capacity_;
+			}
+
+		private:
+			void map();
+			void unmap() noexcept;
+
+			std::byte* data_ = nullptr;
+			std::size_t capacity_ = 0;
+			Mode mode_ = Mode::Read;
+#ifdef _WIN32
+			HANDLE file_ = INVALID_HANDLE_VALUE;
+			HANDLE mapping_ = nullptr;
+#else
+			int file_ = -1;
+#endif
+		};
+
+		struct RecordFileHeader {
+			static constexpr std::array<char, 8> Magic{'M', 'W', 'S', 'I', 'G', 'R', 'E', 'C'};
+			static constexpr std::uint32_t CurrentVersion = 1;
+
+			std::array<char, 8> magic;
+			std::uint32_t version;
+			std::uint32_t reserved;
+			std::uint64_t size; // Bytes in use, header included.
+		};
+
+		struct RecordHeader {
+			std::uint64_t nanoseconds; // Time since the recording started.
+			std::uint32_t id;
+			std::uint32_t payloadSize;
+		};
+
+		static_assert(sizeof(RecordFileHeader) == 24);
+		static_assert(sizeof(RecordHeader) == 16);
+
+		constexpr std::size_t RecordAlignment = 8;
+
+		constexpr std::size_t alignRecord(std::size_t size) noexcept {
+			return (size + RecordAlignment - 1) & ~(RecordAlignment - 1);
+		}
+
+		template <typename... Ts>
+		constexpr std::size_t payloadSize() noexcept {
+			return (std::size_t{0} + ... + sizeof(Ts));
+		}
+
+		template <typename... Ts>
+		constexpr std::array<std::size_t, sizeof...(Ts)> payloadOffsets() noexcept {
+			std::array<std::size_t, sizeof...(Ts)> offsets{};
+			std::size_t offset = 0;
+			std::size_t index = 0;
+			((offsets[index++] = offset, offset += sizeof(Ts)), ...);
+			return offsets;
+		}
+
+		template <typename T>
+		T readPayloadValue(const std::byte* data) noexcept {
+			std::array<std::byte, sizeof(T)> bytes;
+			std::memcpy(bytes.data(), data, sizeof(T));
+			return std::bit_cast<T>(bytes);
+		}
+
+		template <typename... Ts, std::size_t... I>
+		std::tuple<Ts...> readPayload(const std::byte* data, std::index_sequence<I...>) noexcept {
+			constexpr auto offsets = payloadOffsets<Ts...>();
+			return std::tuple<Ts...>{readPayloadValue<Ts>(data + offsets[I])...};
+		}
+
+	}
+
+	/// @brief Records every emission of the attached signals into an append-only memory-mapped
+	/// file. Each record is a timestamp, the signal id and the raw bytes of the arguments, which
+	/// therefore must be trivially copyable. Writing a record is a bump of the write offset,
+	/// the file is only remapped when the reserved capacity is exhausted. Not thread safe.
+	/// The file uses the native byte order and is meant to be replayed on the same platform.
+	class SignalRecorder {
+	public:
+		explicit SignalRecorder(const std::filesystem::path& path, std::size_t capacity = 1 << 20);
+
+		~SignalRecorder();
+
+		SignalRecorder(const SignalRecorder&) = delete;
+		SignalRecorder& operator=(const SignalRecorder&) = delete;
+
+		/// @brief Records all future emissions of the signal under the given id.
+		/// The recording stops when the connection is disconnected or the recorder is destroyed.
+		template <typename... Args>
+		signals::Connection record(Signal<Args...>& signal, std::uint32_t id) {
+			return attach<Args...>(signal, id);
+		}
+
+		template <typename Friend, typename... Args>
+		signals::Connection record(PublicSignal<Friend, Args...>& signal, std::uint32_t id) {
+			return attach<Args...>(signal, id);
+		}
+
+		/// @brief Writes one record. Called by the recorder's slots.
+		template <typename... Args>
+		void write(std::uint32_t id, const Args&... args);
+
+		/// @brief Makes the recorder ignore emissions while paused, e.g. during a replay.
+		void setPaused(bool paused) noexcept {
+			paused_ = paused;
+		}
+
+		bool paused() const noexcept {
+			return paused_;
+		}
+
+		/// @brief Return the number of records written.
+		std::size_t records() const noexcept {
+			return records_;
+		}
+
+		/// @brief Return the number of bytes written to the file, header included.
+		std::size_t bytes() const noexcept {
+			return used_;
+		}
+
+	private:
+		template <typename... Args, typename SignalType>
+		signals::Connection attach(SignalType& signal, std::uint32_t id) {
+			static_assert((std::is_trivially_copyable_v<std::remove_cvref_t<Args>> && ...),
+				"Only signals with trivially copyable arguments can be recorded");
+			auto connection = signal.connect([this, id](Args... args) {
+				if (!paused_) {
+					write<std::remove_cvref_t<Args>...>(id, args...);
+				}
+			});
+			connections_ += connection;
+			return connection;
+		}
+
+		std::byte* allocate(std::size_t size);
+		signals::RecordFileHeader& header() noexcept;
+
+		signals::MappedFile file_;
+		std::size_t used_ = 0;
+		std::size_t records_ = 0;
+		std::chrono::steady_clock::time_point start_;
+		bool paused_ = false;
+		signals::ScopedConnections connections_;
+	};
+
+	/// @brief Replays a file written by SignalRecorder into signals bound by id.
+	class SignalReplayer {
+	public:
+		enum class Timing {
+			FullSpeed,	// Emit all records back to back.
+			Original	// Sleep between records to reproduce the recorded timing.
+		};
+
+		explicit SignalReplayer(const std::filesystem::path& path);
+
+		SignalReplayer(const SignalReplayer&) = delete;
+		SignalReplayer& operator=(const SignalReplayer&) = delete;
+
+		/// @brief Replays records with the given id into the signal.
+		template <typename... Args>
+		void bind(std::uint32_t id, Signal<Args...>& signal) {
+			bind<Args...>(id, [&signal](Args... args) {
+				signal.invoke(args...);
+			});
+		}
+
+		/// @brief Replays records with the given id into the callback, e.g. a private PublicSignal.
+		template <typename... Args, typename Callback>
+		void bind(std::uint32_t id, Callback callback) {
+			using Values = std::tuple<std::remove_cvref_t<Args>...>;
+			static_assert((std::is_trivially_copyable_v<std::remove_cvref_t<Args>> && ...));
+			decoders_[id] = [callback = std::move(callback)](const std::byte* data, std::size_t size) mutable {
+				if (size != signals::payloadSize<std::remove_cvref_t<Args>...>()) {
+					return;
+				}
+				Values values = signals::readPayload<std::remove_cvref_t<Args>...>(data, std::index_sequence_for<Args...>{});
+				std::apply(callback, values);
+			};
+		}
+
+		/// @brief Replays all records in order. Records without a bound id are skipped.
+		/// @return the number of replayed records.
+		std::size_t replay(Timing timing = Timing::FullSpeed);
+
+		/// @brief Return the number of records in the file.
+		std::size_t records() const;
+
+	private:
+		template <typename Function>
+		void forEachRecord(Function&& function) const;
+
+		signals::MappedFile file_;
+		std::size_t size_ = 0;
+		std::unordered_map<std::uint32_t, std::function<void(const std::byte*, std::size_t)>> decoders_;
+	};
+
+	// ------------ Definitions ------------
+
+#ifdef _WIN32
+
+	// Delegates to the default constructor, so the destructor closes the file if the rest throws.
+	inline signals::MappedFile::MappedFile(const std::filesystem::path& path, Mode mode, std::size_t capacity)
+		: MappedFile{} {
+
+		mode_ = mode;
+		const bool write = mode == Mode::Write;
+		file_ = CreateFileW(path.c_str(),
+			write ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+			FILE_SHARE_READ,
+			nullptr,
+			write ? CREATE_ALWAYS : OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL,
+			nullptr);
+		if (file_ == INVALID_HANDLE_VALUE) {
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Failed to open " + path.string());
+		}
+		if (write) {
+			capacity_ = capacity;
+		} else {
+			LARGE_INTEGER size;
+			GetFileSizeEx(file_, &size);
+			capacity_ = static_cast<std::size_t>(size.QuadPart);
+		}
+		map();
+	}
+
+	inline void signals::MappedFile::map() {
+		if (capacity_ == 0) {
+			return;
+		}
+		const bool write = mode_ == Mode::Write;
+		const auto size = static_cast<std::uint64_t>(capacity_);
+		mapping_ = CreateFileMappingW(file_, nullptr, write ? PAGE_READWRITE : PAGE_READONLY,
+			static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xffffffff), nullptr);
+		if (mapping_ == nullptr) {
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Failed to map file");
+		}
+		data_ = static_cast<std::byte*>(MapViewOfFile(mapping_, write ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, capacity_));
+		if (data_ == nullptr) {
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "Failed to map file");
+		}
+	}
+
+	inline void signals::MappedFile::unmap() noexcept {
+		if (data_ != nullptr) {
+			UnmapViewOfFile(data_);
+			data_ = nullptr;
+		}
+		if (mapping_ != nullptr) {
+			CloseHandle(mapping_);
+			mapping_ = nullptr;
+		}
+	}
+
+	inline void signals::MappedFile::close(std::size_t size) {
+		if (file_ == INVALID_HANDLE_VALUE) {
+			return;
+		}
+		unmap();
+		if (mode_ == Mode::Write) {
+			LARGE_INTEGER end;
+			end.QuadPart = static_cast<LONGLONG>(size);
+			SetFilePointerEx(file_, end, nullptr, FILE_BEGIN);
+			SetEndOfFile(file_);
+		}
+		CloseHandle(file_);
+		file_ = INVALID_HANDLE_VALUE;
+		capacity_ = 0;
+	}
+
+#else
+
+	// Delegates to the default constructor, so the destructor closes the file if the rest throws.
+	inline signals::MappedFile::MappedFile(const std::filesystem::path& path, Mode mode, std::size_t capacity)
+		: MappedFile{} {
+
+		mode_ = mode;
+		const bool write = mode == Mode::Write;
+		file_ = ::open(path.c_str(), write ? O_RDWR | O_CREAT | O_TRUNC : O_RDONLY, 0644);
+		if (file_ < 0) {
+			throw std::system_error(errno, std::generic_category(), "Failed to open " + path.string());
+		}
+		if (write) {
+			capacity_ = capacity;
+			if (::ftruncate(file_, static_cast<off_t>(capacity_)) != 0) {
+				throw std::system_error(errno, std::generic_category(), "Failed to resize " + path.string());
+			}
+		} else {
+			struct stat status{};
+			::fstat(file_, &status);
+			capacity_ = static_cast<std::size_t>(status.st_size);
+		}
+		map();
+	}
+
+	inline void signals::MappedFile::map() {
+		if (capacity_ == 0) {
+			return;
+		}
+		const bool write = mode_ == Mode::Write;
+		void* data = ::mmap(nullptr, capacity_, write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file_, 0);
+		if (data == MAP_FAILED) {
+			throw std::system_error(errno, std::generic_category(), "Failed to map file");
+		}
+		data_ = static_cast<std::byte*>(data);
+	}
+
+	inline void signals::MappedFile::unmap() noexcept {
+		if (data_ != nullptr) {
+			::munmap(data_, capacity_);
+			data_ = nullptr;
+		}
+	}
+
+	inline void signals::MappedFile::close(std::size_t size) {
+		if (file_ < 0) {
+			return;
+		}
+		unmap();
+		if (mode_ == Mode::Write) {
+			[[maybe_unused]] int result = ::ftruncate(file_, static_cast<off_t>(size));
+		}
+		::close(file_);
+		file_ = -1;
+		capacity_ = 0;
+	}
+
+#endif
+
+	inline void signals::MappedFile::resize(std::size_t capacity) {
+		unmap();
+		capacity_ = capacity;
+#ifndef _WIN32
+		if (::ftruncate(file_, static_cast<off_t>(capacity_)) != 0) {
+			throw std::system_error(errno, std::generic_category(), "Failed to resize file");
+		}
+#endif
+		map();
+	}
+
+	inline SignalRecorder::SignalRecorder(const std::filesystem::path& path, std::size_t capacity)
+		: file_{path, signals::MappedFile::Mode::Write, std::max(capacity, sizeof(signals::RecordFileHeader))}
+		, used_{sizeof(signals::RecordFileHeader)}
+		, start_{std::chrono::steady_clock::now()} {
+
+		auto& fileHeader = header();
+		fileHeader.magic = signals::RecordFileHeader::Magic;
+		fileHeader.version = signals::RecordFileHeader::CurrentVersion;
+		fileHeader.reserved = 0;
+		fileHeader.size = used_;
+	}
+
+	inline SignalRecorder::~SignalRecorder() {
+		connections_.clear();
+		file_.close(used_);
+	}
+
+	inline signals::RecordFileHeader& SignalRecorder::header() noexcept {
+		return *reinterpret_cast<signals::RecordFileHeader*>(file_.data());
+	}
+
+	inline std::byte* SignalRecorder::allocate(std::size_t size) {
+		if (used_ + size > file_.capacity()) [[unlikely]] {
+			auto capacity = file_.capacity() * 2;
+			while (used_ + size > capacity) {
+				capacity *= 2;
+			}
+			file_.resize(capacity);
+		}
+		auto data = file_.data() + used_;
+		used_ += size;
+		return data;
+	}
+
+	template <typename... Args>
+	void SignalRecorder::write(std::uint32_t id, const Args&... args) {
+		static_assert((std::is_trivially_copyable_v<Args> && ...));
+		constexpr auto payloadSize = signals::payloadSize<Args...>();
+		constexpr auto recordSize = signals::alignRecord(sizeof(signals::RecordHeader) + payloadSize);
+
+		const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+		auto data = allocate(recordSize);
+
+		const signals::RecordHeader recordHeader{
+			.nanoseconds = static_cast<std::uint64_t>(nanoseconds.count()),
+			.id = id,
+			.payloadSize = static_cast<std::uint32_t>(payloadSize)
+		};
+		std::memcpy(data, &recordHeader, sizeof(recordHeader));
+		data += sizeof(recordHeader);
+		((std::memcpy(data, &args, sizeof(Args)), data += sizeof(Args)), ...);
+
+		header().size = used_;
+		++records_;
+	}
+
+	inline SignalReplayer::SignalReplayer(const std::filesystem::path& path)
+		: file_{path, signals::MappedFile::Mode::Read} {
+
+		if (file_.capacity() < sizeof(signals::RecordFileHeader)) {
+			throw std::system_error(std::make_error_code(std::errc::invalid_argument), "Not a signal recording");
+		}
+		signals::RecordFileHeader header;
+		std::memcpy(&header, file_.data(), sizeof(header));
+		if (header.magic != signals::RecordFileHeader::Magic || header.version != signals::RecordFileHeader::CurrentVersion) {
+			throw std::system_error(std::make_error_code(std::errc::invalid_argument), "Not a signal recording");
+		}
+		size_ = std::min(static_cast<std::size_t>(header.size), file_.capacity());
+	}
+
+	template <typename Function>
+	void SignalReplayer::forEachRecord(Function&& function) const {
+		auto offset = sizeof(signals::RecordFileHeader);
+		while (offset + sizeof(signals::RecordHeader) <= size_) {
+			signals::RecordHeader recordHeader;
+			std::memcpy(&recordHeader, file_.data() + offset, sizeof(recordHeader));
+			const auto payload = offset + sizeof(recordHeader);
+			if (payload + recordHeader.payloadSize > size_) {
+				return;
+			}
+			function(recordHeader, file_.data() + payload);
+			offset = signals::alignRecord(payload + recordHeader.payloadSize);
+		}
+	}
+
+	inline std::size_t SignalReplayer::replay(Timing timing) {
+		const auto start = std::chrono::steady_clock::now();
+		std::size_t replayed = 0;
+		forEachRecord([&](const signals::RecordHeader& recordHeader, const std::byte* payload) {
+			auto it = decoders_.find(recordHeader.id);
+			if (it == decoders_.end()) {
+				return;
+			}
+			if (timing == Timing::Original) {
+				std::this_thread::sleep_until(start + std::chrono::nanoseconds{recordHeader.nanoseconds});
+			}
+			it->second(payload, recordHeader.payloadSize);
+			++replayed;
+		});
+		return replayed;
+	}
+
+	inline std::size_t SignalReplayer::records() const {
+		std::size_t records = 0;
+		forEachRecord([&records](const signals::RecordHeader&, const std::byte*) {
+			++records;
+		});
+		return records;
+	}
+
+}
+
+#endif
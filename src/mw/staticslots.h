@@ -0,0 +1,40 @@
+#ifndef SIGNAL_MW_STATICSLOTS_H
+#define SIGNAL_MW_STATICSLOTS_H
+
+#include <functional>
+#include <type_traits>
+
+namespace mw {
+
+	/// @brief A signal with slots fixed at compile time. Invoking calls each slot directly in
+	/// the given order, without type erasure, storage or connections, so the calls can be
+	/// inlined. Has the same invoke interface as Signal and can replace it for fixed wiring.
+	/// @tparam ...Slots functions, function pointers or constexpr callable objects
+	template <auto... Slots>
+	class StaticSlots {
+	public:
+		template <typename... Params>
+		constexpr void operator()(Params&&... params) const {
+			invoke(std::forward<Params>(params)...);
+		}
+
+		/// @brief Calls all slots with the same arguments, i.e. the arguments are never forwarded.
+		template <typename... Params>
+		constexpr void invoke(Params&&... params) const {
+			static_assert((std::is_invocable_v<decltype(Slots), Params&...> && ...),
+				"All slots must be invocable with the arguments");
+			(std::invoke(Slots, params...), ...);
+		}
+
+		static constexpr int size() noexcept {
+			return static_cast<int>(sizeof...(Slots));
+		}
+
+		static constexpr bool empty() noexcept {
+			return sizeof...(Slots) == 0;
+		}
+	};
+
+}
+
+#endif
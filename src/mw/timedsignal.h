@@ -0,0 +1,435 @@
+#ifndef SIGNAL_MW_TIMEDSIGNAL_H
+#define SIGNAL_MW_TIMEDSIGNAL_H
+
+#include "signal.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace mw {
+
+	namespace signals {
+
+		/// @brief Identifies a scheduled timer. Stays invalid after the timer has fired or been canceled.
+		struct TimerId {
+			std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+			std::uint32_t generation = 0;
+
+			friend bool operator==(const TimerId&, const TimerId&) = default;
+		};
+
+		/// @brief Hierarchical timer wheel with four levels of 256 buckets. Scheduling and canceling
+		/// are O(1), timers are kept in intrusive lists over a recycled node pool. Time only moves
+		/// when the application calls advance(). Not thread safe.
+		class TimerWheel {
+		public:
+			using Clock = std::chrono::steady_clock;
+			using Duration = Clock::duration;
+			using Callback = MoveOnlyFunction<void()>; // Small callables are stored in the node.
+
+			explicit TimerWheel(Duration resolution = std::chrono::milliseconds{1})
+				: resolution_{resolution} {
+				buckets_.fill(Invalid);
+			}
+
+			TimerWheel(const TimerWheel&) = delete;
+			TimerWheel& operator=(const TimerWheel&) = delete;
+
+			/// @brief Calls the callback when at least the delay has passed. A delay shorter than
+			/// the resolution fires on the next tick.
+			TimerId schedule(Duration delay, Callback callback);
+
+			/// @brief Moves a pending timer to expire after the delay from now, keeping its callback.
+			/// @return true if the timer was pending.
+			bool reschedule(TimerId id, Duration delay) noexcept;
+
+			/// @brief Cancels a pending timer.
+			/// @return true if the timer was pending.
+			bool cancel(TimerId id) noexcept;
+
+			bool pending(TimerId id) const noexcept;
+
+			/// @brief Moves time forward, firing all timers that expire on the way in order.
+			void advance(Duration elapsed);
+
+			/// @brief Return the number of pending timers.
+			std::size_t size() const noexcept {
+				return size_;
+			}
+
+			Duration resolution() const noexcept {
+				return resolution_;
+			}
+
+			/// @brief Return the current time in ticks since the wheel was created.
+			std::uint64_t now() const noexcept {
+				return now_;
+			}
+
+		private:
+			static constexpr std::uint32_t Invalid = std::numeric_limits<std::uint32_t>::max();
+			static constexpr int Levels = 4;
+			static constexpr int BucketBits = 8;
+			static constexpr std::uint64_t BucketsPerLevel = std::uint64_t{1} << BucketBits;
+			static constexpr std::uint64_t BucketMask = BucketsPerLevel - 1;
+
+			struct Node {
+				std::uint64_t expires = 0;
+				Callback callback;
+				std::uint32_t prev = Invalid;
+				std::uint32_t next = Invalid;
+				std::uint32_t bucket = Invalid; // Invalid when free.
+				std::uint32_t generation = 0;
+			};
+
+			std::uint64_t expiry(Duration delay) const noexcept;
+			void tick();
+			void cascade(int level);
+			void link(std::uint32_t index);
+			void unlink(std::uint32_t index) noexcept;
+			void release(std::uint32_t index) noexcept;
+
+			TrackedVector<Node> nodes_;
+			TrackedVector<std::uint32_t> free_;
+			std::array<std::uint32_t, Levels * BucketsPerLevel> buckets_;
+			Duration resolution_;
+			Duration remainder_{};
+			std::uint64_t now_ = 0;
+			std::size_t size_ = 0;
+		};
+
+	}
+
+	/// @brief A Signal whose invokes can be delayed, debounced or throttled, driven by a TimerWheel.
+	/// The wheel must outlive the signal. Pending emissions are dropped when the signal is destroyed.
+	/// @tparam ...Args the slots invoke arguments
+	template <typename... Args>
+	class TimedSignal {
+	public:
+		using Duration = signals::TimerWheel::Duration;
+		using Callback = typename Signal<Args...>::Callback;
+
+		explicit TimedSignal(signals::TimerWheel& wheel)
+			: wheel_{&wheel}
+			, state_{signals::detail::makeShared<State>()} {
+		}
+
+		~TimedSignal() {
+			if (state_) {
+				wheel_->cancel(state_->timer);
+			}
+		}
+
+		TimedSignal(const TimedSignal&) = delete;
+		TimedSignal& operator=(const TimedSignal&) = delete;
+
+		TimedSignal(TimedSignal&&) noexcept = default;
+
+		TimedSignal& operator=(TimedSignal&& signal) noexcept {
+			if (this != &signal) {
+				if (state_) {
+					wheel_->cancel(state_->timer);
+				}
+				wheel_ = signal.wheel_;
+				state_ = std::move(signal.state_);
+			}
+			return *this;
+		}
+
+		[[nodiscard]] signals::Connection connect(const Callback& callback) {
+			return state_->signal.connect(callback);
+		}
+
+		template <typename T, typename... TArgs>
+		[[nodiscard]] signals::Connection connect(T* object, void(T::* ptr)(TArgs... args)) {
+			return state_->signal.connect(object, ptr);
+		}
+
+		/// @brief Invokes the slots now, or according to the debounce or throttle setting.
+		template <typename... Params>
+		void operator()(Params&&... params) {
+			invoke(std::forward<Params>(params)...);
+		}
+
+		template <typename... Params>
+		void invoke(Params&&... params);
+
+		/// @brief Invokes the slots after the delay, independent of debounce and throttle.
+		signals::TimerId emitAfter(Duration delay, Args... args);
+
+		/// @brief Cancels an emission scheduled by emitAfter.
+		bool cancel(signals::TimerId id) noexcept {
+			return wheel_->cancel(id);
+		}
+
+		/// @brief Invokes are delayed until no new invoke has been made for the duration,
+		/// then the slots are invoked once with the latest arguments. Zero turns it off.
+		void setDebounce(Duration duration) noexcept {
+			state_->mode = Mode::Debounce;
+			state_->duration = duration;
+		}
+
+		/// @brief Invokes the slots at most once per duration. The first invoke is made
+		/// immediately, the latest of the following is made when the duration has passed.
+		/// Zero turns it off.
+		void setThrottle(Duration duration) noexcept {
+			state_->mode = Mode::Throttle;
+			state_->duration = duration;
+		}
+
+		/// @brief Drops a pending debounced or throttled invoke.
+		void cancelPending() noexcept {
+			wheel_->cancel(state_->timer);
+			state_->latest.reset();
+			state_->throttling = false;
+		}
+
+		void clear() {
+			state_->signal.clear();
+		}
+
+		int size() const noexcept {
+			return state_->signal.size();
+		}
+
+		bool empty() const noexcept {
+			return state_->signal.empty();
+		}
+
+	private:
+		using Values = std::tuple<std::remove_cvref_t<Args>...>;
+
+		enum class Mode {
+			Immediate,
+			Debounce,
+			Throttle
+		};
+
+		// Kept on the heap to give timer callbacks a stable, weakly referenced target.
+		struct State {
+			Signal<Args...> signal;
+			Mode mode = Mode::Immediate;
+			Duration duration{};
+			signals::TimerId timer;
+			std::optional<Values> latest;
+			bool throttling = false;
+		};
+
+		static void emitLatest(const std::weak_ptr<State>& weakState, signals::TimerWheel& wheel);
+
+		signals::TimerWheel* wheel_;
+		std::shared_ptr<State> state_;
+	};
+
+	// ------------ Definitions ------------
+
+	inline signals::TimerId signals::TimerWheel::schedule(Duration delay, Callback callback) {
+		std::uint32_t index;
+		if (free_.empty()) {
+			index = static_cast<std::uint32_t>(nodes_.size());
+			nodes_.emplace_back();
+		} else {
+			index = free_.back();
+			free_.pop_back();
+		}
+		auto& node = nodes_[index];
+		node.expires = expiry(delay);
+		node.callback = std::move(callback);
+		link(index);
+		++size_;
+		return {index, node.generation};
+	}
+
+	inline bool signals::TimerWheel::reschedule(TimerId id, Duration delay) noexcept {
+		if (!pending(id)) {
+			return false;
+		}
+		unlink(id.index);
+		nodes_[id.index].expires = expiry(delay);
+		link(id.index);
+		return true;
+	}
+
+	inline bool signals::TimerWheel::cancel(TimerId id) noexcept {
+		if (!pending(id)) {
+			return false;
+		}
+		unlink(id.index);
+		release(id.index);
+		return true;
+	}
+
+	inline bool signals::TimerWheel::pending(TimerId id) const noexcept {
+		return id.index < nodes_.size()
+			&& nodes_[id.index].generation == id.generation
+			&& nodes_[id.index].bucket != Invalid;
+	}
+
+	inline void signals::TimerWheel::advance(Duration elapsed) {
+		remainder_ += elapsed;
+		auto ticks = remainder_ / resolution_;
+		remainder_ -= ticks * resolution_;
+		for (; ticks > 0; --ticks) {
+			if (size_ == 0) {
+				now_ += static_cast<std::uint64_t>(ticks);
+				return;
+			}
+			tick();
+		}
+	}
+
+	inline std::uint64_t signals::TimerWheel::expiry(Duration delay) const noexcept {
+		const auto ticks = (delay + resolution_ - Duration{1}) / resolution_;
+		return now_ + static_cast<std::uint64_t>(ticks > 0 ? ticks : 1);
+	}
+
+	inline void signals::TimerWheel::tick() {
+		++now_;
+		for (int level = 1; level < Levels; ++level) {
+			// Cascade a higher level each time all lower levels have wrapped around.
+			if (((now_ >> (BucketBits * level - BucketBits)) & BucketMask) != 0) {
+				break;
+			}
+			cascade(level);
+		}
+		auto& head = buckets_[now_ & BucketMask];
+		while (head != Invalid) {
+			const auto index = head;
+			unlink(index);
+			auto callback = std::move(nodes_[index].callback);
+			release(index);
+			// May schedule and cancel timers, new ones expire at the earliest next tick.
+			callback();
+		}
+	}
+
+	inline void signals::TimerWheel::cascade(int level) {
+		const auto bucket = level * BucketsPerLevel + ((now_ >> (BucketBits * level)) & BucketMask);
+		auto index = buckets_[bucket];
+		buckets_[bucket] = Invalid;
+		while (index != Invalid) {
+			const auto next = nodes_[index].next;
+			link(index);
+			index = next;
+		}
+	}
+
+	inline void signals::TimerWheel::link(std::uint32_t index) {
+		auto& node = nodes_[index];
+		const auto delta = node.expires - now_;
+		std::uint64_t bucket;
+		if (delta < BucketsPerLevel) {
+			bucket = node.expires & BucketMask;
+		} else if (delta < (std::uint64_t{1} << (2 * BucketBits))) {
+			bucket = BucketsPerLevel + ((node.expires >> BucketBits) & BucketMask);
+		} else if (delta < (std::uint64_t{1} << (3 * BucketBits))) {
+			bucket = 2 * BucketsPerLevel + ((node.expires >> (2 * BucketBits)) & BucketMask);
+		} else {
+			// Timers beyond the last level wait in its farthest bucket and are cascaded again.
+			const auto max = std::uint64_t{1} << (4 * BucketBits);
+			const auto expires = delta < max ? node.expires : now_ + max - 1;
+			bucket = 3 * BucketsPerLevel + ((expires >> (3 * BucketBits)) & BucketMask);
+		}
+		node.bucket = static_cast<std::uint32_t>(bucket);
+		node.prev = Invalid;
+		node.next = buckets_[bucket];
+		if (node.next != Invalid) {
+			nodes_[node.next].prev = index;
+		}
+		buckets_[bucket] = index;
+	}
+
+	inline void signals::TimerWheel::unlink(std::uint32_t index) noexcept {
+		auto& node = nodes_[index];
+		if (node.prev != Invalid) {
+			nodes_[node.prev].next = node.next;
+		} else {
+			buckets_[node.bucket] = node.next;
+		}
+		if (node.next != Invalid) {
+			nodes_[node.next].prev = node.prev;
+		}
+		node.prev = Invalid;
+		node.next = Invalid;
+	}
+
+	inline void signals::TimerWheel::release(std::uint32_t index) noexcept {
+		auto& node = nodes_[index];
+		node.bucket = Invalid;
+		node.callback = nullptr;
+		++node.generation;
+		free_.push_back(index);
+		--size_;
+	}
+
+	template <typename... Args>
+	template <typename... Params>
+	void TimedSignal<Args...>::invoke(Params&&... params) {
+		auto& state = *state_;
+		if (state.duration == Duration::zero() || state.mode == Mode::Immediate) {
+			state.signal.invoke(std::forward<Params>(params)...);
+			return;
+		}
+		if (state.mode == Mode::Throttle && !state.throttling) {
+			state.throttling = true;
+			state.timer = wheel_->schedule(state.duration, [weakState = std::weak_ptr{state_}, wheel = wheel_]() {
+				emitLatest(weakState, *wheel);
+			});
+			state.signal.invoke(std::forward<Params>(params)...);
+			return;
+		}
+		state.latest.emplace(std::forward<Params>(params)...);
+		// Re-arming only moves the pending timer, nothing is allocated.
+		if (state.mode == Mode::Debounce && !wheel_->reschedule(state.timer, state.duration)) {
+			state.timer = wheel_->schedule(state.duration, [weakState = std::weak_ptr{state_}, wheel = wheel_]() {
+				emitLatest(weakState, *wheel);
+			});
+		}
+	}
+
+	template <typename... Args>
+	void TimedSignal<Args...>::emitLatest(const std::weak_ptr<State>& weakState, signals::TimerWheel& wheel) {
+		auto state = weakState.lock();
+		if (!state) {
+			return;
+		}
+		if (!state->latest) {
+			// Throttle window closed without new invokes.
+			state->throttling = false;
+			return;
+		}
+		auto values = std::move(*state->latest);
+		state->latest.reset();
+		if (state->mode == Mode::Throttle) {
+			// Emitting the trailing invoke opens a new window.
+			state->timer = wheel.schedule(state->duration, [weakState, &wheel]() {
+				emitLatest(weakState, wheel);
+			});
+		}
+		std::apply([&state](auto&... values) {
+			state->signal.invoke(values...);
+		}, values);
+	}
+
+	template <typename... Args>
+	signals::TimerId TimedSignal<Args...>::emitAfter(Duration delay, Args... args) {
+		return wheel_->schedule(delay, [weakState = std::weak_ptr{state_}, values = Values{std::forward<Args>(args)...}]() mutable {
+			if (auto state = weakState.lock()) {
+				std::apply([&state](auto&... values) {
+					state->signal.invoke(values...);
+				}, values);
+			}
+		});
+	}
+
+}
+
+#endif
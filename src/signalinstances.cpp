@@ -0,0 +1,5 @@
+#include "mw/signalinstances.h"
+
+#define MW_SIGNAL_INSTANTIATE(...) template class mw::Signal<__VA_ARGS__>;
+MW_SIGNAL_INSTANCES(MW_SIGNAL_INSTANTIATE)
+#undef MW_SIGNAL_INSTANTIATE